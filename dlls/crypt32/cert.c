@@ -1549,8 +1549,24 @@ static BOOL compare_cert_by_cert_id(PCCERT_CONTEXT pCertContext, DWORD dwType,
         break;
     case CERT_ID_KEY_IDENTIFIER:
     {
-        DWORD size = 0;
+        BYTE key_id[20];
+        DWORD size = sizeof(key_id), err = GetLastError();
+
+        /* key identifiers are usually SHA-1 hashes, so avoid querying the
+         * size and allocating a buffer for every certificate */
+        if (id->u.KeyId.cbData <= sizeof(key_id))
+        {
+            ret = CertGetCertificateContextProperty(pCertContext,
+             CERT_KEY_IDENTIFIER_PROP_ID, key_id, &size);
+            /* a larger key identifier can't match, don't report it */
+            if (!ret && GetLastError() == ERROR_MORE_DATA)
+                SetLastError(err);
+            ret = ret && size == id->u.KeyId.cbData &&
+             !memcmp(key_id, id->u.KeyId.pbData, size);
+            break;
+        }
 
+        size = 0;
         ret = CertGetCertificateContextProperty(pCertContext,
          CERT_KEY_IDENTIFIER_PROP_ID, NULL, &size);
         if (ret && size == id->u.KeyId.cbData)
@@ -1181,6 +1181,7 @@ void secondarybuffer_destroy(IDirectSoundBufferImpl *This)
     free(This->notifies);
     free(This->pwfx);
     free(This->committedbuff);
+    DSOUND_ReleaseFirBank(This);
 
     if (This->filters) {
         int i;
@@ -1261,6 +1262,7 @@ HRESULT IDirectSoundBufferImpl_Duplicate(
     dsb->committedbuff = committedbuff;
     dsb->use_committed = FALSE;
     dsb->committed_mixpos = 0;
+    dsb->fir_bank = NULL;
     DSOUND_RecalcFormat(dsb);
 
     InitializeSRWLock(&dsb->lock);
@@ -1272,6 +1274,7 @@ HRESULT IDirectSoundBufferImpl_Duplicate(
         dsb->buffer->ref--;
         free(dsb->pwfx);
         free(dsb->committedbuff);
+        DSOUND_ReleaseFirBank(dsb);
         free(dsb);
         dsb = NULL;
     }else
@@ -328,6 +328,29 @@ void mixieee32(float *src, float *dst, unsigned samples)
         *(dst++) += *(src++);
 }
 
+void mixieee32_vol(float *src, float *dst, unsigned frames, unsigned channels, const float *vols)
+{
+    unsigned i, chan;
+
+    TRACE("%p - %p %u %u\n", src, dst, frames, channels);
+
+    if (channels == 2)
+    {
+        float left = vols[0], right = vols[1];
+
+        for (i = 0; i < frames; i++)
+        {
+            dst[2 * i] += src[2 * i] * left;
+            dst[2 * i + 1] += src[2 * i + 1] * right;
+        }
+        return;
+    }
+
+    for (i = 0; i < frames; i++)
+        for (chan = 0; chan < channels; chan++)
+            dst[i * channels + chan] += src[i * channels + chan] * vols[chan];
+}
+
 static void norm8(float *src, unsigned char *dst, unsigned samples)
 {
     TRACE("%p - %p %d\n", src, dst, samples);
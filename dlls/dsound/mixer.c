@@ -86,6 +86,119 @@ void DSOUND_AmpFactorToVolPan(PDSVOLUMEPAN volpan)
     TRACE("Vol=%ld Pan=%ld\n", volpan->lVolume, volpan->lPan);
 }
 
+/* Polyphase filter banks, shared between all the buffers that resample with
+ * the same ratio.  Each phase holds the FIR coefficients, interpolated and
+ * scaled by firgain, for one fractional input position. */
+struct fir_bank
+{
+    struct list entry;
+    LONG ref;
+    LONG64 num, den;    /* reduced resampling ratio */
+    UINT firstep;
+    UINT taps;          /* coefficients per phase, a multiple of 4 */
+    float coeffs[1];    /* den phases of taps coefficients each */
+};
+
+/* don't bother caching ratios needing more than 1 MiB of coefficients */
+#define FIR_BANK_MAX_COEFFS (256 * 1024)
+
+static struct list fir_banks = LIST_INIT(fir_banks);
+static CRITICAL_SECTION fir_banks_cs;
+static CRITICAL_SECTION_DEBUG fir_banks_cs_debug =
+{
+    0, 0, &fir_banks_cs,
+    { &fir_banks_cs_debug.ProcessLocksList, &fir_banks_cs_debug.ProcessLocksList },
+      0, 0, { (DWORD_PTR)(__FILE__ ": fir_banks_cs") }
+};
+static CRITICAL_SECTION fir_banks_cs = { &fir_banks_cs_debug, -1, 0, 0, 0, 0 };
+
+static LONG64 gcd64(LONG64 a, LONG64 b)
+{
+    while (b)
+    {
+        LONG64 t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+static struct fir_bank *get_fir_bank(LONG64 num, LONG64 den, UINT firstep, float firgain)
+{
+    LONG64 g = gcd64(num, den);
+    struct fir_bank *bank;
+    UINT phase, taps, idx, j;
+
+    num /= g;
+    den /= g;
+    taps = ((fir_len + firstep - 2) / firstep + 3) & ~3;
+    if (den > FIR_BANK_MAX_COEFFS / taps)
+    {
+        TRACE("not caching %s/%s ratio\n", wine_dbgstr_longlong(num), wine_dbgstr_longlong(den));
+        return NULL;
+    }
+
+    EnterCriticalSection(&fir_banks_cs);
+
+    LIST_FOR_EACH_ENTRY(bank, &fir_banks, struct fir_bank, entry)
+    {
+        if (bank->num == num && bank->den == den && bank->firstep == firstep)
+        {
+            bank->ref++;
+            LeaveCriticalSection(&fir_banks_cs);
+            return bank;
+        }
+    }
+
+    if (!(bank = malloc(offsetof(struct fir_bank, coeffs[den * taps]))))
+    {
+        LeaveCriticalSection(&fir_banks_cs);
+        return NULL;
+    }
+    bank->ref = 1;
+    bank->num = num;
+    bank->den = den;
+    bank->firstep = firstep;
+    bank->taps = taps;
+
+    for (phase = 0; phase < den; phase++)
+    {
+        float *coeffs = bank->coeffs + phase * taps;
+        UINT int_fir_steps = phase * firstep / den;
+        float rem = int_fir_steps + 1.0 - phase * firstep / (float)den;
+
+        idx = firstep - int_fir_steps - 1;
+        for (j = 0; idx < fir_len - 1; j++, idx += firstep)
+            coeffs[j] = (fir[idx] * (1.0 - rem) + fir[idx + 1] * rem) * firgain;
+        for (; j < taps; j++)
+            coeffs[j] = 0.0f;
+    }
+
+    list_add_tail(&fir_banks, &bank->entry);
+    TRACE("created bank %p for %s/%s, %u phases of %u taps\n", bank, wine_dbgstr_longlong(num),
+            wine_dbgstr_longlong(den), (UINT)den, taps);
+
+    LeaveCriticalSection(&fir_banks_cs);
+    return bank;
+}
+
+void DSOUND_ReleaseFirBank(IDirectSoundBufferImpl *dsb)
+{
+    struct fir_bank *bank = dsb->fir_bank;
+
+    if (!bank)
+        return;
+    dsb->fir_bank = NULL;
+
+    EnterCriticalSection(&fir_banks_cs);
+    if (!--bank->ref)
+    {
+        list_remove(&bank->entry);
+        free(bank);
+    }
+    LeaveCriticalSection(&fir_banks_cs);
+}
+
 /**
  * Recalculate the size for temporary buffer, and new writelead
  * Should be called when one of the following things occur:
@@ -127,6 +240,10 @@ void DSOUND_RecalcFormat(IDirectSoundBufferImpl *dsb)
 	}
 	dsb->firgain = (float)dsb->firstep / fir_step;
 
+	DSOUND_ReleaseFirBank(dsb);
+	if (dsb->freqAdjustNum != dsb->freqAdjustDen)
+		dsb->fir_bank = get_fir_bank(dsb->freqAdjustNum, dsb->freqAdjustDen, dsb->firstep, dsb->firgain);
+
 	/* calculate the 10ms write lead */
 	dsb->writelead = (dsb->freq / 100) * dsb->pwfx->nBlockAlign;
 
@@ -311,6 +428,45 @@ static UINT cp_fields_noresample(IDirectSoundBufferImpl *dsb, UINT count)
     return count;
 }
 
+static inline float fir_dot(const float *coeffs, const float *samples, UINT taps)
+{
+    float sum[4] = {0.0f};
+    UINT i, j;
+
+    /* four independent accumulators, so that this can be vectorized */
+    for (i = 0; i < taps; i += 4)
+        for (j = 0; j < 4; j++)
+            sum[j] += coeffs[i + j] * samples[i + j];
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+static void resample_fir_bank(IDirectSoundBufferImpl *dsb, const struct fir_bank *bank,
+        const float *intermediate, UINT required_input, UINT count, LONG64 freqAcc_start)
+{
+    UINT ostride = dsb->device->pwfx->nChannels * sizeof(float);
+    LONG64 g = dsb->freqAdjustDen / bank->den;
+    UINT step_int = bank->num / bank->den, step_frac = bank->num % bank->den;
+    UINT ipos = freqAcc_start / dsb->freqAdjustDen;
+    UINT phase = (freqAcc_start % dsb->freqAdjustDen) / g;
+    UINT i, channel;
+
+    for (i = 0; i < count; ++i) {
+        const float *coeffs = bank->coeffs + phase * bank->taps;
+
+        assert(ipos + bank->taps <= required_input);
+
+        for (channel = 0; channel < dsb->mix_channels; channel++)
+            dsb->put(dsb, i * ostride, channel,
+                    fir_dot(coeffs, &intermediate[channel * required_input + ipos], bank->taps));
+
+        ipos += step_int;
+        if ((phase += step_frac) >= bank->den) {
+            phase -= bank->den;
+            ipos++;
+        }
+    }
+}
+
 static UINT cp_fields_resample(IDirectSoundBufferImpl *dsb, UINT count, LONG64 *freqAccNum)
 {
     UINT i, channel;
@@ -324,19 +480,26 @@ static UINT cp_fields_resample(IDirectSoundBufferImpl *dsb, UINT count, LONG64 *
     UINT channels = dsb->mix_channels;
     UINT max_ipos = (freqAcc_start + count * dsb->freqAdjustNum) / dsb->freqAdjustDen;
 
+    const struct fir_bank *bank = dsb->fir_bank;
     UINT fir_cachesize = (fir_len + dsbfirstep - 2) / dsbfirstep;
-    UINT required_input = max_ipos + fir_cachesize;
+    UINT required_input;
     float *intermediate, *fir_copy, *itmp;
-
-    DWORD len = required_input * channels;
-    len += fir_cachesize;
-    len *= sizeof(float);
+    DWORD len;
 
     *freqAccNum = freqAcc_end % dsb->freqAdjustDen;
 
     if (!secondarybuffer_is_audible(dsb))
         return max_ipos;
 
+    /* the bank only holds the phases reachable from a zero accumulator */
+    if (bank && freqAcc_start % (dsb->freqAdjustDen / bank->den))
+        bank = NULL;
+
+    required_input = max_ipos + (bank ? bank->taps : fir_cachesize);
+    len = required_input * channels;
+    len += fir_cachesize;
+    len *= sizeof(float);
+
     if (!dsb->device->cp_buffer) {
         dsb->device->cp_buffer = malloc(len);
         dsb->device->cp_buffer_len = len;
@@ -367,6 +530,11 @@ static UINT cp_fields_resample(IDirectSoundBufferImpl *dsb, UINT count, LONG64 *
                     dsb->buflen, dsb->sec_mixpos + i * istride, channel);
     }
 
+    if (bank) {
+        resample_fir_bank(dsb, bank, intermediate, required_input, count, freqAcc_start);
+        return max_ipos;
+    }
+
     for(i = 0; i < count; ++i) {
         UINT int_fir_steps = (freqAcc_start + i * dsb->freqAdjustNum) * dsbfirstep / dsb->freqAdjustDen;
         float total_fir_steps = (freqAcc_start + i * dsb->freqAdjustNum) * dsbfirstep / (float)dsb->freqAdjustDen;
@@ -482,35 +650,33 @@ static void DSOUND_MixToTemporary(IDirectSoundBufferImpl *dsb, DWORD frames)
 	}
 }
 
-static void DSOUND_MixerVol(const IDirectSoundBufferImpl *dsb, INT frames)
+/**
+ * Compute the per-channel amplification factors of the given buffer.
+ * Returns FALSE if no volume needs to be applied.
+ */
+static BOOL DSOUND_MixerVol(const IDirectSoundBufferImpl *dsb, float *vols)
 {
-	INT	i;
-	float vols[DS_MAX_CHANNELS];
 	UINT channels = dsb->device->pwfx->nChannels, chan;
 
-	TRACE("(%p,%d)\n",dsb,frames);
+	TRACE("(%p)\n",dsb);
 	TRACE("left = %lx, right = %lx\n", dsb->volpan.dwTotalAmpFactor[0],
 		dsb->volpan.dwTotalAmpFactor[1]);
 
 	if ((!(dsb->dsbd.dwFlags & DSBCAPS_CTRLPAN) || (dsb->volpan.lPan == 0)) &&
 	    (!(dsb->dsbd.dwFlags & DSBCAPS_CTRLVOLUME) || (dsb->volpan.lVolume == 0)) &&
 	     !(dsb->dsbd.dwFlags & DSBCAPS_CTRL3D))
-		return; /* Nothing to do */
+		return FALSE; /* Nothing to do */
 
 	if (channels > DS_MAX_CHANNELS)
 	{
 		FIXME("There is no support for %u channels\n", channels);
-		return;
+		return FALSE;
 	}
 
-	for (i = 0; i < channels; ++i)
-		vols[i] = dsb->volpan.dwTotalAmpFactor[i] / ((float)0xFFFF);
+	for (chan = 0; chan < channels; ++chan)
+		vols[chan] = dsb->volpan.dwTotalAmpFactor[chan] / ((float)0xFFFF);
 
-	for(i = 0; i < frames; ++i){
-		for(chan = 0; chan < channels; ++chan){
-			dsb->device->tmp_buffer[i * channels + chan] *= vols[chan];
-		}
-	}
+	return TRUE;
 }
 
 /**
@@ -539,10 +705,14 @@ static DWORD DSOUND_MixInBuffer(IDirectSoundBufferImpl *dsb, float *mix_buffer,
 	ibuf = dsb->device->tmp_buffer;
 
 	if (secondarybuffer_is_audible(dsb)) {
-		/* Apply volume if needed */
-		DSOUND_MixerVol(dsb, frames);
-
-		mixieee32(ibuf, mix_buffer, frames * dsb->device->pwfx->nChannels);
+		UINT channels = dsb->device->pwfx->nChannels;
+		float vols[DS_MAX_CHANNELS];
+
+		/* Apply volume if needed, while mixing */
+		if (DSOUND_MixerVol(dsb, vols))
+			mixieee32_vol(ibuf, mix_buffer, frames, channels, vols);
+		else
+			mixieee32(ibuf, mix_buffer, frames * channels);
 	}
 
 	/* check for notification positions */
@@ -686,7 +856,7 @@ static void DSOUND_WaveQueue(DirectSoundDevice *device, LPBYTE pos, DWORD bytes)
  *
  * secondary->buffer (secondary format)
  *   =[Resample]=> device->tmp_buffer (float format)
- *   =[Volume]=> device->tmp_buffer (float format)
+ *   =[Volume and mix]=> device->buffer (float format)
  *   =[Reformat]=> device->buffer (device format, skipped on float)
  */
 static void DSOUND_PerformMix(DirectSoundDevice *device)
@@ -3840,6 +3840,29 @@ static int compare_string( const struct sortguid *sortid, DWORD flags,
     init_sortkey_state( &s1, flags, srclen1, primary1, sizeof(primary1) );
     init_sortkey_state( &s2, flags, srclen2, primary2, sizeof(primary2) );
 
+    /* Identical leading characters with plain weights add the same values to all
+     * keys of both strings, so they can be skipped. The last one is processed
+     * anyway since a following nonspace mark modifies its diacritic weight. */
+    if (!(sortid->flags & FLAG_REVERSEDIACRITICS))
+    {
+        int skip = 0;
+
+        while (skip < srclen1 && skip < srclen2 && src1[skip] == src2[skip])
+        {
+            union char_weights weights = get_char_weights( src1[skip], except );
+
+            if (weights._case & CASE_COMPR_6) break;
+            if (weights.script < SCRIPT_DIGIT || weights.script >= SCRIPT_PUA_FIRST) break;
+            if (weights.script == SCRIPT_DIGIT && (flags & SORT_DIGITSASNUMBERS)) break;
+            skip++;
+        }
+        if (skip > 1)
+        {
+            pos1 = pos2 = skip - 1;
+            s1.primary_pos = s2.primary_pos = 2 * (skip - 1);
+        }
+    }
+
     while (pos1 < srclen1 || pos2 < srclen2)
     {
         while (pos1 < srclen1 && !s1.key_primary.len)
@@ -489,16 +489,23 @@ static UINT create_folder( MSIPACKAGE *package, const WCHAR *dir )
     return ERROR_SUCCESS;
 }
 
-static MSIFILE *find_file( MSIPACKAGE *package, UINT disk_id, const WCHAR *filename )
+static MSIFILE *find_file( MSIPACKAGE *package, MSIFILE *start, const WCHAR *filename )
 {
-    MSIFILE *file;
+    struct list *ptr = &start->entry;
 
-    LIST_FOR_EACH_ENTRY( file, &package->files, MSIFILE, entry )
+    /* files are usually stored in the cabinet in sequence order, so start
+     * looking from the previously extracted one and wrap around */
+    do
     {
-        if (file->disk_id == disk_id &&
+        MSIFILE *file = LIST_ENTRY( ptr, MSIFILE, entry );
+
+        if (file->disk_id == start->disk_id &&
             file->state != msifs_installed &&
             !wcsicmp( filename, file->File )) return file;
-    }
+
+        if (!(ptr = list_next( &package->files, ptr ))) ptr = list_head( &package->files );
+    } while (ptr != &start->entry);
+
     return NULL;
 }
 
@@ -509,7 +516,7 @@ static BOOL installfiles_cb(MSIPACKAGE *package, LPCWSTR filename, DWORD action,
 
     if (action == MSICABEXTRACT_BEGINEXTRACT)
     {
-        if (!(file = find_file( package, file->disk_id, filename )))
+        if (!(file = find_file( package, file, filename )))
         {
             TRACE("unknown file in cabinet (%s)\n", debugstr_w(filename));
             return FALSE;
@@ -55,6 +55,8 @@ struct column_info
     UINT    type;
     UINT    offset;
     struct column_hash_entry **hash_table;
+    UINT    hash_size;
+    UINT    hash_count;
 };
 
 struct tagMSITABLE
@@ -355,10 +357,28 @@ end:
     return ret;
 }
 
+static void free_column_hash( struct column_info *col )
+{
+    struct column_hash_entry *entry, *next;
+    UINT i;
+
+    if (!col->hash_table) return;
+    for (i = 0; i < col->hash_size; i++)
+    {
+        for (entry = col->hash_table[i]; entry; entry = next)
+        {
+            next = entry->next;
+            free( entry );
+        }
+    }
+    free( col->hash_table );
+    col->hash_table = NULL;
+}
+
 static void free_colinfo( struct column_info *colinfo, UINT count )
 {
     UINT i;
-    for (i = 0; i < count; i++) free( colinfo[i].hash_table );
+    for (i = 0; i < count; i++) free_column_hash( &colinfo[i] );
 }
 
 static void free_table( MSITABLE *table )
@@ -1041,6 +1061,116 @@ static UINT TABLE_fetch_int( struct tagMSIVIEW *view, UINT row, UINT col, UINT *
     return ERROR_SUCCESS;
 }
 
+/* Column hash tables map the values of a column to the rows containing them.
+ * Entries within a bucket are sorted by row, and the tables are kept up to
+ * date when rows are inserted, deleted or modified. */
+static void column_hash_link( struct column_info *col, struct column_hash_entry *entry )
+{
+    struct column_hash_entry **ptr = &col->hash_table[entry->value % col->hash_size];
+
+    while (*ptr && (*ptr)->row < entry->row) ptr = &(*ptr)->next;
+    entry->next = *ptr;
+    *ptr = entry;
+}
+
+static BOOL column_hash_resize( struct column_info *col, UINT size )
+{
+    struct column_hash_entry **old_table = col->hash_table, *entry, *next;
+    UINT i, old_size = col->hash_size;
+
+    if (!(col->hash_table = calloc( size, sizeof(*col->hash_table) )))
+    {
+        col->hash_table = old_table;
+        return FALSE;
+    }
+    col->hash_size = size;
+
+    for (i = 0; i < old_size; i++)
+    {
+        for (entry = old_table[i]; entry; entry = next)
+        {
+            next = entry->next;
+            column_hash_link( col, entry );
+        }
+    }
+    free( old_table );
+    return TRUE;
+}
+
+static BOOL column_hash_add( struct column_info *col, UINT row, UINT val )
+{
+    struct column_hash_entry *entry;
+
+    if (col->hash_count >= 2 * col->hash_size && !column_hash_resize( col, 4 * col->hash_size + 1 ))
+        return FALSE;
+    if (!(entry = malloc( sizeof(*entry) )))
+        return FALSE;
+
+    entry->value = val;
+    entry->row = row;
+    column_hash_link( col, entry );
+    col->hash_count++;
+    return TRUE;
+}
+
+static struct column_hash_entry **column_hash_find( struct column_info *col, UINT row, UINT val )
+{
+    struct column_hash_entry **ptr = &col->hash_table[val % col->hash_size];
+
+    while (*ptr && (*ptr)->row != row) ptr = &(*ptr)->next;
+    return ptr;
+}
+
+static void column_hash_remove( struct column_info *col, UINT row, UINT val )
+{
+    struct column_hash_entry **ptr = column_hash_find( col, row, val ), *entry;
+
+    if (!(entry = *ptr)) return;
+    *ptr = entry->next;
+    free( entry );
+    col->hash_count--;
+}
+
+/* renumber the entries starting at row after rows were inserted or deleted */
+static void column_hash_shift( struct column_info *col, UINT row, int delta )
+{
+    struct column_hash_entry *entry;
+    UINT i;
+
+    for (i = 0; i < col->hash_size; i++)
+    {
+        for (entry = col->hash_table[i]; entry; entry = entry->next)
+            if (entry->row >= row) entry->row += delta;
+    }
+}
+
+static UINT build_column_hash( struct table_view *tv, UINT col )
+{
+    struct column_info *info = &tv->columns[col - 1];
+    UINT r, row, val;
+
+    info->hash_size = max( MSITABLE_HASH_TABLE_SIZE, tv->table->row_count | 1 );
+    info->hash_count = 0;
+    if (!(info->hash_table = calloc( info->hash_size, sizeof(*info->hash_table) )))
+        return ERROR_NOT_ENOUGH_MEMORY;
+
+    /* add the rows backwards, so that each entry goes to the front of its bucket */
+    for (row = tv->table->row_count; row--;)
+    {
+        if ((r = TABLE_fetch_int( &tv->view, row, col, &val )) != ERROR_SUCCESS)
+        {
+            free_column_hash( info );
+            return r;
+        }
+        if (!column_hash_add( info, row, val ))
+        {
+            free_column_hash( info );
+            return ERROR_NOT_ENOUGH_MEMORY;
+        }
+    }
+    return ERROR_SUCCESS;
+}
+
 static UINT get_stream_name( const struct table_view *tv, UINT row, WCHAR **pstname )
 {
     LPWSTR p, stname = NULL;
@@ -1176,9 +1306,6 @@ static UINT table_set_bytes( struct table_view *tv, UINT row, UINT col, UINT val
         return ERROR_FUNCTION_FAILED;
     }
 
-    free( tv->columns[col-1].hash_table );
-    tv->columns[col-1].hash_table = NULL;
-
     n = bytes_per_column( tv->db, &tv->columns[col - 1], LONG_STR_BYTES );
     if ( n != 2 && n != 3 && n != 4 )
     {
@@ -1187,6 +1314,17 @@ static UINT table_set_bytes( struct table_view *tv, UINT row, UINT col, UINT val
     }
 
     offset = tv->columns[col-1].offset;
+    if (tv->columns[col-1].hash_table)
+    {
+        UINT old_val = read_table_int( tv->table->data, row, offset, n );
+
+        if (old_val != val)
+        {
+            column_hash_remove( &tv->columns[col-1], row, old_val );
+            if (!column_hash_add( &tv->columns[col-1], row, val ))
+                free_column_hash( &tv->columns[col-1] );
+        }
+    }
     for ( i = 0; i < n; i++ )
         tv->table->data[row][offset + i] = (val >> i * 8) & 0xff;
 
@@ -1726,6 +1864,11 @@ static UINT TABLE_insert_row( struct tagMSIVIEW *view, MSIRECORD *rec, UINT row,
         return r;
 
     /* shift the rows to make room for the new row */
+    if (row < tv->table->row_count - 1)
+    {
+        for (i = 0; i < tv->num_cols; i++)
+            if (tv->columns[i].hash_table) column_hash_shift( &tv->columns[i], row, 1 );
+    }
     for (i = tv->table->row_count - 1; i > row; i--)
     {
         memmove(&(tv->table->data[i][0]),
@@ -1735,7 +1878,21 @@ static UINT TABLE_insert_row( struct tagMSIVIEW *view, MSIRECORD *rec, UINT row,
 
     /* Re-set the persistence flag */
     tv->table->data_persistent[row] = !temporary;
-    return TABLE_set_row( view, row, rec, (1<<tv->num_cols) - 1 );
+    r = TABLE_set_row( view, row, rec, (1<<tv->num_cols) - 1 );
+
+    /* add the new row to the hash tables, values that were already
+     * present in the row storage are not written by TABLE_set_row */
+    for (i = 0; i < tv->num_cols; i++)
+    {
+        struct column_info *col = &tv->columns[i];
+        UINT val;
+
+        if (!col->hash_table) continue;
+        if (r != ERROR_SUCCESS || TABLE_fetch_int( view, row, i + 1, &val ) != ERROR_SUCCESS ||
+            (!*column_hash_find( col, row, val ) && !column_hash_add( col, row, val )))
+            free_column_hash( col );
+    }
+    return r;
 }
 
 static UINT TABLE_delete_row( struct tagMSIVIEW *view, UINT row )
@@ -1756,15 +1913,24 @@ static UINT TABLE_delete_row( struct tagMSIVIEW *view, UINT row )
         return ERROR_FUNCTION_FAILED;
 
     num_rows = tv->table->row_count;
-    tv->table->row_count--;
 
-    /* reset the hash tables */
     for (i = 0; i < tv->num_cols; i++)
     {
-        free(tv->columns[i].hash_table);
-        tv->columns[i].hash_table = NULL;
+        struct column_info *col = &tv->columns[i];
+        UINT val;
+
+        if (!col->hash_table) continue;
+        if (TABLE_fetch_int( view, row, i + 1, &val ) != ERROR_SUCCESS)
+        {
+            free_column_hash( col );
+            continue;
+        }
+        column_hash_remove( col, row, val );
+        if (row < num_rows - 1) column_hash_shift( col, row + 1, -1 );
     }
 
+    tv->table->row_count--;
+
     for (i = row + 1; i < num_rows; i++)
     {
         memcpy(tv->table->data[i - 1], tv->table->data[i], tv->row_size);
@@ -1947,6 +2113,7 @@ static UINT TABLE_remove_column(struct tagMSIVIEW *view, UINT number)
     if (tv->table->colinfo[number-1].type & MSITYPE_TEMPORARY)
     {
         UINT size = tv->table->colinfo[number-1].offset;
+        free_column_hash( &tv->table->colinfo[number-1] );
         tv->table->col_count--;
         tv->table->colinfo = realloc(tv->table->colinfo, sizeof(*tv->table->colinfo) * tv->table->col_count);
 
@@ -2771,7 +2938,7 @@ UINT TransformView_Create( MSIDATABASE *db, string_table *st, LPCWSTR name, MSIV
     static const WCHAR query_sfx[] = L"' AND `Row` IS NULL AND `Current` IS NOT NULL AND `new` = 1";
 
     WCHAR buf[256], *query = buf;
-    UINT r, len, name_len, size, add_col;
+    UINT r, len, name_len, size, add_col, i;
     struct column_info *colinfo;
     struct table_view *tv;
     MSIRECORD *rec;
@@ -2881,6 +3048,7 @@ UINT TransformView_Create( MSIDATABASE *db, string_table *st, LPCWSTR name, MSIV
     msiobj_release( &q->hdr );
 
     memcpy( colinfo, tv->columns, tv->num_cols * sizeof(*colinfo) );
+    for (i = 0; i < tv->num_cols; i++) colinfo[i].hash_table = NULL;
     tv->columns = colinfo;
     tv->num_cols += add_col;
     return ERROR_SUCCESS;
@@ -3149,6 +3317,40 @@ static UINT row_matches( struct table_view *tv, UINT row, const UINT *data, UINT
     return ret;
 }
 
+/* find a row using the hash table of the first primary key column */
+static BOOL table_find_row_hashed( struct table_view *tv, const UINT *data, UINT *row, UINT *column, UINT *ret )
+{
+    const struct column_hash_entry *entry;
+    struct column_info *key;
+    UINT i;
+
+    /* transform views use their own copy of the column info */
+    if (tv->columns != tv->table->colinfo)
+        return FALSE;
+
+    for (i = 0; i < tv->num_cols; i++)
+        if (tv->columns[i].type & MSITYPE_KEY) break;
+    if (i == tv->num_cols)
+        return FALSE;
+
+    key = &tv->columns[i];
+    if (!key->hash_table && build_column_hash( tv, i + 1 ) != ERROR_SUCCESS)
+        return FALSE;
+
+    *ret = ERROR_FUNCTION_FAILED;
+    for (entry = key->hash_table[data[i] % key->hash_size]; entry; entry = entry->next)
+    {
+        if (entry->value != data[i]) continue;
+        if (row_matches( tv, entry->row, data, column ) == ERROR_SUCCESS)
+        {
+            *row = entry->row;
+            *ret = ERROR_SUCCESS;
+            break;
+        }
+    }
+    return TRUE;
+}
+
 static UINT table_find_row( struct table_view *tv, MSIRECORD *rec, UINT *row, UINT *column )
 {
     UINT i, r = ERROR_FUNCTION_FAILED, *data;
@@ -3156,6 +3358,11 @@ static UINT table_find_row( struct table_view *tv, MSIRECORD *rec, UINT *row, UI
     data = record_to_row( tv, rec );
     if( !data )
         return r;
+    if (table_find_row_hashed( tv, data, row, column, &r ))
+    {
+        free( data );
+        return r;
+    }
     for( i = 0; i < tv->table->row_count; i++ )
     {
         r = row_matches( tv, i, data, column );
@@ -8818,6 +8818,74 @@ static void test_primary_keys(void)
     DeleteFileA(msifile);
 }
 
+static void test_primary_key_lookup(void)
+{
+    MSIHANDLE hdb, hview, hrec;
+    char query[128], expect[16], buffer[16];
+    UINT r, i, count;
+    DWORD size;
+
+    hdb = create_db();
+
+    r = run_query(hdb, 0, "CREATE TABLE `T` (`A` SHORT NOT NULL, `B` CHAR(72) PRIMARY KEY `A`)");
+    ok(r == ERROR_SUCCESS, "got %u\n", r);
+
+    /* insert in descending key order, so that existing rows get shifted */
+    for (i = 200; i > 0; i--)
+    {
+        sprintf(query, "INSERT INTO `T` (`A`, `B`) VALUES (%u, 'row%u')", i, i);
+        r = run_query(hdb, 0, query);
+        ok(r == ERROR_SUCCESS, "%u: got %u\n", i, r);
+    }
+
+    for (i = 1; i <= 200; i += 7)
+    {
+        sprintf(query, "INSERT INTO `T` (`A`, `B`) VALUES (%u, 'new')", i);
+        r = run_query(hdb, 0, query);
+        ok(r == ERROR_FUNCTION_FAILED, "%u: got %u\n", i, r);
+    }
+
+    r = run_query(hdb, 0, "DELETE FROM `T` WHERE `A` < 50");
+    ok(r == ERROR_SUCCESS, "got %u\n", r);
+
+    for (i = 1; i <= 200; i += 7)
+    {
+        sprintf(query, "INSERT INTO `T` (`A`, `B`) VALUES (%u, 'new')", i);
+        r = run_query(hdb, 0, query);
+        ok(r == (i < 50 ? ERROR_SUCCESS : ERROR_FUNCTION_FAILED), "%u: got %u\n", i, r);
+    }
+
+    r = MsiDatabaseOpenViewA(hdb, "SELECT `A`, `B` FROM `T` ORDER BY `A`", &hview);
+    ok(r == ERROR_SUCCESS, "got %u\n", r);
+    r = MsiViewExecute(hview, 0);
+    ok(r == ERROR_SUCCESS, "got %u\n", r);
+
+    count = 0;
+    while (MsiViewFetch(hview, &hrec) == ERROR_SUCCESS)
+    {
+        i = MsiRecordGetInteger(hrec, 1);
+        if (i < 50)
+        {
+            ok(i % 7 == 1, "unexpected row %u\n", i);
+            strcpy(expect, "new");
+        }
+        else sprintf(expect, "row%u", i);
+
+        size = sizeof(buffer);
+        r = MsiRecordGetStringA(hrec, 2, buffer, &size);
+        ok(r == ERROR_SUCCESS, "got %u\n", r);
+        ok(!strcmp(buffer, expect), "%u: got %s\n", i, buffer);
+        MsiCloseHandle(hrec);
+        count++;
+    }
+    ok(count == 158, "got %u rows\n", count);
+
+    MsiViewClose(hview);
+    MsiCloseHandle(hview);
+    MsiCloseHandle(hdb);
+    DeleteFileA(msifile);
+}
+
 static void test_viewmodify_merge(void)
 {
     MSIHANDLE view, rec, db = create_db();
@@ -9432,6 +9500,7 @@ START_TEST(db)
     test_embedded_nulls();
     test_select_column_names();
     test_primary_keys();
+    test_primary_key_lookup();
     test_viewmodify_merge();
     test_viewmodify_insert();
     test_view_get_error();
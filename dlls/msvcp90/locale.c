@@ -250,6 +250,87 @@ static void ostreambuf_iterator_wchar_put(ostreambuf_iterator_wchar *this, wchar
         this->failed = TRUE;
 }
 
+/* Writes count characters, copying directly into the put area while it has room */
+static void ostreambuf_iterator_char_put_n(ostreambuf_iterator_char *this, const char *ptr, size_t count)
+{
+    size_t avail;
+
+    while(count && !this->failed) {
+        if(!*this->strbuf->pwpos || *this->strbuf->pwsize <= 0) {
+            ostreambuf_iterator_char_put(this, *ptr++);
+            count--;
+            continue;
+        }
+
+        avail = min(count, (size_t)*this->strbuf->pwsize);
+        memcpy(*this->strbuf->pwpos, ptr, avail);
+        *this->strbuf->pwpos += avail;
+        *this->strbuf->pwsize -= avail;
+        ptr += avail;
+        count -= avail;
+    }
+}
+
+static void ostreambuf_iterator_char_rep(ostreambuf_iterator_char *this, char ch, size_t count)
+{
+    size_t avail;
+
+    while(count && !this->failed) {
+        if(!*this->strbuf->pwpos || *this->strbuf->pwsize <= 0) {
+            ostreambuf_iterator_char_put(this, ch);
+            count--;
+            continue;
+        }
+
+        avail = min(count, (size_t)*this->strbuf->pwsize);
+        memset(*this->strbuf->pwpos, ch, avail);
+        *this->strbuf->pwpos += avail;
+        *this->strbuf->pwsize -= avail;
+        count -= avail;
+    }
+}
+
+static void ostreambuf_iterator_wchar_put_n(ostreambuf_iterator_wchar *this, const wchar_t *ptr, size_t count)
+{
+    size_t avail;
+
+    while(count && !this->failed) {
+        if(!*this->strbuf->pwpos || *this->strbuf->pwsize <= 0) {
+            ostreambuf_iterator_wchar_put(this, *ptr++);
+            count--;
+            continue;
+        }
+
+        avail = min(count, (size_t)*this->strbuf->pwsize);
+        memcpy(*this->strbuf->pwpos, ptr, avail*sizeof(wchar_t));
+        *this->strbuf->pwpos += avail;
+        *this->strbuf->pwsize -= avail;
+        ptr += avail;
+        count -= avail;
+    }
+}
+
+static void ostreambuf_iterator_wchar_rep(ostreambuf_iterator_wchar *this, wchar_t ch, size_t count)
+{
+    wchar_t *ptr;
+    size_t avail;
+
+    while(count && !this->failed) {
+        if(!*this->strbuf->pwpos || *this->strbuf->pwsize <= 0) {
+            ostreambuf_iterator_wchar_put(this, ch);
+            count--;
+            continue;
+        }
+
+        avail = min(count, (size_t)*this->strbuf->pwsize);
+        for(ptr = *this->strbuf->pwpos; ptr < *this->strbuf->pwpos + avail; ptr++)
+            *ptr = ch;
+        *this->strbuf->pwpos += avail;
+        *this->strbuf->pwsize -= avail;
+        count -= avail;
+    }
+}
+
 /* ??1facet@locale@std@@UAE@XZ */
 /* ??1facet@locale@std@@UEAA@XZ */
 /* ??1facet@locale@std@@MAA@XZ */
@@ -6494,6 +6575,30 @@ int __cdecl num_get_char__Getifld(const num_get *this, char *dest, istreambuf_it
         MSVCP_basic_string_char_ctor(&groups_found);
         if(found_zero) ++groups_no;
     }
+    else if(first->strbuf && *first->strbuf->prpos && *first->strbuf->prsize > 0)
+    {
+        /* no thousands separators, consume the digits directly from the get area */
+        char *ptr = *first->strbuf->prpos, *end = ptr + *first->strbuf->prsize;
+
+        for(; ptr<end && memchr(digits, *ptr, base); ptr++) {
+            error = FALSE;
+            if(dest_empty && *ptr == '0')
+            {
+                found_zero = TRUE;
+                continue;
+            }
+            dest_empty = FALSE;
+            if(dest < dest_end)
+                *dest++ = *ptr;
+        }
+
+        if(ptr != *first->strbuf->prpos) {
+            *first->strbuf->prsize -= ptr - *first->strbuf->prpos;
+            *first->strbuf->prpos = ptr;
+            first->got = FALSE;
+            istreambuf_iterator_char_val(first);
+        }
+    }
 
     for(; first->strbuf; istreambuf_iterator_char_inc(first)) {
         if(!memchr(digits, first->val, base)) {
@@ -7216,8 +7321,7 @@ ostreambuf_iterator_char* __cdecl num_put_char__Put(const num_put *this, ostream
 {
     TRACE("(%p %p %p %Iu)\n", this, ret, ptr, count);
 
-    for(; count>0; count--)
-        ostreambuf_iterator_char_put(&dest, *ptr++);
+    ostreambuf_iterator_char_put_n(&dest, ptr, count);
 
     *ret = dest;
     return ret;
@@ -7230,8 +7334,7 @@ ostreambuf_iterator_char* __cdecl num_put_char__Putc(const num_put *this, ostrea
 {
     TRACE("(%p %p %p %Iu)\n", this, ret, ptr, count);
 
-    for(; count>0; count--)
-        ostreambuf_iterator_char_put(&dest, *ptr++);
+    ostreambuf_iterator_char_put_n(&dest, ptr, count);
 
     *ret = dest;
     return ret;
@@ -7253,8 +7356,7 @@ ostreambuf_iterator_char* __cdecl num_put_char__Rep(const num_put *this, ostream
 {
     TRACE("(%p %p %d %Iu)\n", this, ret, c, count);
 
-    for(; count>0; count--)
-        ostreambuf_iterator_char_put(&dest, c);
+    ostreambuf_iterator_char_rep(&dest, c, count);
 
     *ret = dest;
     return ret;
@@ -8038,8 +8140,7 @@ ostreambuf_iterator_wchar* __cdecl num_put_wchar__Put(const num_put *this, ostre
 {
     TRACE("(%p %p %s %Iu)\n", this, ret, debugstr_wn(ptr, count), count);
 
-    for(; count>0; count--)
-        ostreambuf_iterator_wchar_put(&dest, *ptr++);
+    ostreambuf_iterator_wchar_put_n(&dest, ptr, count);
 
     *ret = dest;
     return ret;
@@ -8054,15 +8155,19 @@ ostreambuf_iterator_wchar* __cdecl num_put_wchar__Putc(const num_put *this, ostr
         ostreambuf_iterator_wchar dest, const char *ptr, size_t count)
 {
     _Mbstatet state;
-    wchar_t ch;
+    wchar_t buf[64];
+    size_t len = 0;
 
     TRACE("(%p %p %s %Iu)\n", this, ret, debugstr_an(ptr, count), count);
 
     memset(&state, 0, sizeof(state));
     for(; count>0; count--) {
-        if(_Mbrtowc(&ch, ptr++, 1, &state, &this->cvt) == 1)
-            ostreambuf_iterator_wchar_put(&dest, ch);
+        if(_Mbrtowc(buf+len, ptr++, 1, &state, &this->cvt) == 1 && ++len == ARRAY_SIZE(buf)) {
+            ostreambuf_iterator_wchar_put_n(&dest, buf, len);
+            len = 0;
+        }
     }
+    ostreambuf_iterator_wchar_put_n(&dest, buf, len);
 
     *ret = dest;
     return ret;
@@ -8089,8 +8194,7 @@ ostreambuf_iterator_wchar* __cdecl num_put_wchar__Rep(const num_put *this, ostre
 {
     TRACE("(%p %p %d %Iu)\n", this, ret, c, count);
 
-    for(; count>0; count--)
-        ostreambuf_iterator_wchar_put(&dest, c);
+    ostreambuf_iterator_wchar_rep(&dest, c, count);
 
     *ret = dest;
     return ret;
@@ -8165,11 +8269,18 @@ static void num_put_wchar_wide_put(const num_put *this,
                 const char *buf, size_t count)
 {
     ctype_wchar *ctype;
-    size_t i;
+    wchar_t wbuf[64];
+    size_t i, len;
 
     ctype = ctype_wchar_use_facet(IOS_LOCALE(base));
-    for(i=0; i<count; i++)
-        ostreambuf_iterator_wchar_put(dest, ctype_wchar_widen_ch(ctype, buf[i]));
+    while(count) {
+        len = min(count, ARRAY_SIZE(wbuf));
+        for(i=0; i<len; i++)
+            wbuf[i] = ctype_wchar_widen_ch(ctype, buf[i]);
+        ostreambuf_iterator_wchar_put_n(dest, wbuf, len);
+        buf += len;
+        count -= len;
+    }
 }
 #endif
 
@@ -9031,7 +9142,7 @@ ostreambuf_iterator_char* __thiscall time_put_char_do_put(const time_put *this,
         ostreambuf_iterator_char dest, ios_base *base, char fill, const struct tm *t, char spec, char mod)
 {
     char buf[64], fmt[4], *p = fmt;
-    size_t i, len;
+    size_t len;
 
     TRACE("(%p %p %p %c %p %c %c)\n", this, ret, base, fill, t, spec, mod);
 
@@ -9042,8 +9153,7 @@ ostreambuf_iterator_char* __thiscall time_put_char_do_put(const time_put *this,
     *p++ = 0;
 
     len = _Strftime(buf, sizeof(buf), fmt, t, this->time.timeptr);
-    for(i=0; i<len; i++)
-        ostreambuf_iterator_char_put(&dest, buf[i]);
+    ostreambuf_iterator_char_put_n(&dest, buf, len);
 
     *ret = dest;
     return ret;
@@ -9113,7 +9223,7 @@ ostreambuf_iterator_char* __thiscall time_put_char_do_put(const time_put *this,
         ostreambuf_iterator_char dest, ios_base *base, const struct tm *t, char spec, char mod)
 {
     char buf[64], fmt[4], *p = fmt;
-    size_t i, len;
+    size_t len;
 
     TRACE("(%p %p %p %p %c %c)\n", this, ret, base, t, spec, mod);
 
@@ -9124,8 +9234,7 @@ ostreambuf_iterator_char* __thiscall time_put_char_do_put(const time_put *this,
     *p++ = 0;
 
     len = _Strftime(buf, sizeof(buf), fmt, t, this->time.timeptr);
-    for(i=0; i<len; i++)
-        ostreambuf_iterator_char_put(&dest, buf[i]);
+    ostreambuf_iterator_char_put_n(&dest, buf, len);
 
     *ret = dest;
     return ret;
@@ -9449,7 +9558,7 @@ ostreambuf_iterator_wchar* __thiscall time_put_wchar_do_put(const time_put *this
     char buf[64], fmt[4], *p = fmt;
     size_t i, len;
     const _Cvtvec *cvt;
-    wchar_t c;
+    wchar_t wbuf[64];
 
     TRACE("(%p %p %p %c %p %c %c)\n", this, ret, base, fill, t, spec, mod);
 
@@ -9466,10 +9575,9 @@ ostreambuf_iterator_wchar* __thiscall time_put_wchar_do_put(const time_put *this
 #endif
 
     len = _Strftime(buf, sizeof(buf), fmt, t, this->time.timeptr);
-    for(i=0; i<len; i++) {
-        c = mb_to_wc(buf[i], cvt);
-        ostreambuf_iterator_wchar_put(&dest, c);
-    }
+    for(i=0; i<len; i++)
+        wbuf[i] = mb_to_wc(buf[i], cvt);
+    ostreambuf_iterator_wchar_put_n(&dest, wbuf, len);
 
     *ret = dest;
     return ret;
@@ -9560,7 +9668,7 @@ ostreambuf_iterator_wchar* __thiscall time_put_wchar_do_put(const time_put *this
 {
     char buf[64], fmt[4], *p = fmt;
     size_t i, len;
-    wchar_t c;
+    wchar_t wbuf[64];
 
     TRACE("(%p %p %p %p %c %c)\n", this, ret, base, t, spec, mod);
 
@@ -9571,10 +9679,9 @@ ostreambuf_iterator_wchar* __thiscall time_put_wchar_do_put(const time_put *this
     *p++ = 0;
 
     len = _Strftime(buf, sizeof(buf), fmt, t, this->time.timeptr);
-    for(i=0; i<len; i++) {
-        c = mb_to_wc(buf[i], &this->cvt);
-        ostreambuf_iterator_wchar_put(&dest, c);
-    }
+    for(i=0; i<len; i++)
+        wbuf[i] = mb_to_wc(buf[i], &this->cvt);
+    ostreambuf_iterator_wchar_put_n(&dest, wbuf, len);
 
     *ret = dest;
     return ret;
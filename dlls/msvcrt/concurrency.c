@@ -145,6 +145,7 @@ typedef struct {
     HANDLE *shutdown_events;
     CRITICAL_SECTION cs;
     struct list scheduled_chores;
+    struct list free_chores;
 } ThreadScheduler;
 extern const vtable_ptr ThreadScheduler_vtable;
 
@@ -1034,7 +1035,7 @@ static void remove_scheduled_chores(Scheduler *scheduler, const ExternalContextB
                              struct scheduled_chore, entry) {
         if (sc->chore->task_collection->context == &context->context) {
             list_remove(&sc->entry);
-            operator_delete(sc);
+            list_add_head(&tscheduler->free_chores, &sc->entry);
         }
     }
     LeaveCriticalSection(&tscheduler->cs);
@@ -1377,6 +1378,9 @@ static void ThreadScheduler_dtor(ThreadScheduler *this)
     LIST_FOR_EACH_ENTRY_SAFE(sc, next, &this->scheduled_chores,
             struct scheduled_chore, entry)
         operator_delete(sc);
+    LIST_FOR_EACH_ENTRY_SAFE(sc, next, &this->free_chores,
+            struct scheduled_chore, entry)
+        operator_delete(sc);
 }
 
 DEFINE_THISCALL_WRAPPER(ThreadScheduler_Id, 4)
@@ -1604,6 +1608,7 @@ static ThreadScheduler* ThreadScheduler_ctor(ThreadScheduler *this,
     this->cs.DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": ThreadScheduler");
 
     list_init(&this->scheduled_chores);
+    list_init(&this->free_chores);
     return this;
 }
 
@@ -2116,8 +2121,8 @@ void __thiscall _StructuredTaskCollection__Cancel(
             continue;
         sc->chore->task_collection = NULL;
         list_remove(&sc->entry);
+        list_add_head(&scheduler->free_chores, &sc->entry);
         removed++;
-        operator_delete(sc);
     }
     LeaveCriticalSection(&scheduler->cs);
     if (!removed)
@@ -2237,15 +2242,16 @@ static BOOL pick_and_execute_chore(ThreadScheduler *scheduler)
     EnterCriticalSection(&scheduler->cs);
     entry = list_head(&scheduler->scheduled_chores);
     if (entry)
+    {
         list_remove(entry);
+        sc = LIST_ENTRY(entry, struct scheduled_chore, entry);
+        chore = sc->chore;
+        list_add_head(&scheduler->free_chores, &sc->entry);
+    }
     LeaveCriticalSection(&scheduler->cs);
     if (!entry)
         return FALSE;
 
-    sc = LIST_ENTRY(entry, struct scheduled_chore, entry);
-    chore = sc->chore;
-    operator_delete(sc);
-
     chore->chore_wrapper(chore);
     return TRUE;
 }
@@ -2260,6 +2266,7 @@ static bool schedule_chore(_StructuredTaskCollection *this,
 {
     struct scheduled_chore *sc;
     ThreadScheduler *scheduler;
+    struct list *entry;
 
     if (chore->task_collection) {
         invalid_multiple_scheduling e;
@@ -2276,14 +2283,24 @@ static bool schedule_chore(_StructuredTaskCollection *this,
         return FALSE;
     }
 
-    sc = operator_new(sizeof(*sc));
+    EnterCriticalSection(&scheduler->cs);
+    if ((entry = list_head(&scheduler->free_chores)))
+    {
+        list_remove(entry);
+        sc = LIST_ENTRY(entry, struct scheduled_chore, entry);
+    }
+    else
+    {
+        LeaveCriticalSection(&scheduler->cs);
+        sc = operator_new(sizeof(*sc));
+        EnterCriticalSection(&scheduler->cs);
+    }
     sc->chore = chore;
 
     chore->task_collection = this;
     chore->chore_wrapper = chore_wrapper;
     InterlockedIncrement(&this->count);
 
-    EnterCriticalSection(&scheduler->cs);
     list_add_head(&scheduler->scheduled_chores, &sc->entry);
     LeaveCriticalSection(&scheduler->cs);
     *pscheduler = &scheduler->scheduler;
@@ -2971,6 +2971,19 @@ static int read_i(int fd, ioinfo *fdinfo, void *buf, unsigned int count)
 
             for (i=0, j=0; i<num_read; i+=1+utf16)
             {
+                /* move runs of characters that don't need translation at once */
+                if (!utf16 && bufstart[i] != '\r' && bufstart[i] != 0x1a)
+                {
+                    DWORD len = 1;
+
+                    while (i + len < num_read && bufstart[i + len] != '\r' && bufstart[i + len] != 0x1a)
+                        len++;
+                    if (i != j) memmove(bufstart + j, bufstart + i, len);
+                    j += len;
+                    i += len - 1;
+                    continue;
+                }
+
                 /* in text mode, a ctrl-z signals EOF */
                 if (bufstart[i]==0x1a && (!utf16 || bufstart[i+1]==0))
                 {
@@ -3661,11 +3674,21 @@ int CDECL _write(int fd, const void* buf, unsigned int count)
         }
         else if (ioinfo_get_textmode(info) == TEXTMODE_ANSI)
         {
-            for (j = 0; i < count && j < sizeof(lfbuf)-1; i++, j++)
+            while (i < count && j < sizeof(lfbuf)-1)
             {
-                if (s[i] == '\n')
+                DWORD len = min(count - i, sizeof(lfbuf) - 1 - j);
+                const char *nl = memchr(s + i, '\n', len);
+
+                if (nl) len = nl - (s + i);
+                memcpy(lfbuf + j, s + i, len);
+                i += len;
+                j += len;
+                if (nl)
+                {
                     lfbuf[j++] = '\r';
-                lfbuf[j] = s[i];
+                    lfbuf[j++] = '\n';
+                    i++;
+                }
             }
         }
         else if (ioinfo_get_textmode(info) == TEXTMODE_UTF16LE || console)
@@ -3910,10 +3933,28 @@ char * CDECL fgets(char *s, int size, FILE* file)
 
   _lock_file(file);
 
-  while ((size >1) && (cc = _fgetc_nolock(file)) != EOF && cc != '\n')
+  while (size > 1)
     {
-      *s++ = (char)cc;
-      size --;
+      if (file->_cnt > 0)
+        {
+          /* copy directly from the buffer up to the end of line */
+          int len = min(file->_cnt, size - 1);
+          char *nl = memchr(file->_ptr, '\n', len);
+
+          if (nl) len = nl - file->_ptr + 1;
+          memcpy(s, file->_ptr, len);
+          file->_ptr += len;
+          file->_cnt -= len;
+          s += len;
+          size -= len;
+          cc = (unsigned char)s[-1];
+        }
+      else if ((cc = _filbuf(file)) != EOF)
+        {
+          *s++ = (char)cc;
+          size--;
+        }
+      if (cc == EOF || cc == '\n') break;
     }
   if ((cc == EOF) && (s == buf_start)) /* If nothing read, return 0*/
   {
@@ -3921,8 +3962,6 @@ char * CDECL fgets(char *s, int size, FILE* file)
     _unlock_file(file);
     return NULL;
   }
-  if ((cc != EOF) && (size > 1))
-    *s++ = cc;
   *s = '\0';
   TRACE(":got %s\n", debugstr_a(buf_start));
   _unlock_file(file);
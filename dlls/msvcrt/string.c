@@ -742,6 +742,47 @@ static inline BOOL bnum_to_mant(struct bnum *b, ULONGLONG *m)
     return TRUE;
 }
 
+/* Converts m*10^e to fpnum using 64-bit arithmetic, used for numbers with up
+ * to 19 significant digits when 5^|e| fits in 64 bits. The result is exact,
+ * or carries the rounding information of the remainder, so it produces the
+ * same value as the bnum based conversion. */
+static BOOL fpnum_from_decimal(int sign, ULONGLONG m, int e, struct fpnum *ret)
+{
+    ULONGLONG p5 = 1, q, r;
+    enum fpmod mod;
+    int i, e2;
+
+    if(e < -27 || e > 27) return FALSE;
+    for(i = 0; i < abs(e); i++) p5 *= 5;
+
+    if(e >= 0) {
+        if(m > UI64_MAX / p5) return FALSE;
+        *ret = fpnum(sign, e, m * p5, FP_ROUND_ZERO);
+        return TRUE;
+    }
+
+    /* m*10^e = m/5^-e * 2^e, generate quotient bits until the top one is set */
+    q = m / p5;
+    r = m % p5;
+    e2 = e;
+    while(!(q >> 63)) {
+        q <<= 1;
+        r <<= 1;
+        if(r >= p5) {
+            r -= p5;
+            q |= 1;
+        }
+        e2--;
+    }
+
+    if(!r) mod = FP_ROUND_ZERO;
+    else if(r > p5 - r) mod = FP_ROUND_UP;
+    else if(r == p5 - r) mod = FP_ROUND_EVEN;
+    else mod = FP_ROUND_DOWN;
+    *ret = fpnum(sign, e2, q, mod);
+    return TRUE;
+}
+
 static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(void *ctx),
         void *ctx, pthreadlocinfo locinfo, BOOL ldouble, struct bnum *b)
 {
@@ -752,10 +793,11 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
     int matched=0;
 #endif
     BOOL found_digit = FALSE, found_dp = FALSE, found_sign = FALSE;
-    int e2 = 0, dp=0, sign=1, off, limb_digits = 0, i;
+    int e2 = 0, dp=0, sign=1, off, limb_digits = 0, i, digits = 0;
     enum fpmod round = FP_ROUND_ZERO;
+    struct fpnum ret;
     wchar_t nch;
-    ULONGLONG m;
+    ULONGLONG m, m10 = 0;
 
     nch = get(ctx);
     if(nch == '-') {
@@ -826,6 +868,10 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
 
         b->data[bnum_idx(b, b->b)] = b->data[bnum_idx(b, b->b)] * 10 + nch - '0';
         limb_digits++;
+        if(digits <= 19) {
+            m10 = m10 * 10 + nch - '0';
+            digits++;
+        }
         nch = get(ctx);
         dp++;
     }
@@ -862,6 +908,10 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
 
         b->data[bnum_idx(b, b->b)] = b->data[bnum_idx(b, b->b)] * 10 + nch - '0';
         limb_digits++;
+        if(digits <= 19) {
+            m10 = m10 * 10 + nch - '0';
+            digits++;
+        }
         nch = get(ctx);
     }
     while(nch>='0' && nch<='9') {
@@ -917,6 +967,10 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
     if(!b->data[bnum_idx(b, b->e-1)])
         return fpnum(sign, 0, 0, 0);
 
+    if(digits <= 19 && dp > INT_MIN + digits &&
+            fpnum_from_decimal(sign, m10, dp - digits, &ret))
+        return ret;
+
     /* Fill last limb with 0 if needed */
     if(b->b+1 != b->e) {
         for(; limb_digits != LIMB_DIGITS; limb_digits++)
@@ -1559,13 +1613,23 @@ int CDECL _atoldbl(_LDOUBLE *value, char *str)
     return _atoldbl_l( (MSVCRT__LDOUBLE*)value, str, NULL );
 }
 
+/* checks 8 bytes at once, the aligned loads never cross a page boundary */
+static inline BOOL has_zero_byte(uint64_t v)
+{
+    return ((v - 0x0101010101010101ull) & ~v & 0x8080808080808080ull) != 0;
+}
+
 /*********************************************************************
  *              strlen (MSVCRT.@)
  */
 size_t __cdecl strlen(const char *str)
 {
     const char *s = str;
-    while (*s) s++;
+    const uint64_t *w;
+
+    for (; (ULONG_PTR)s & 7; s++) if (!*s) return s - str;
+    for (w = (const uint64_t *)s; !has_zero_byte(*w); w++) ;
+    for (s = (const char *)w; *s; s++) ;
     return s - str;
 }
 
@@ -3270,9 +3334,15 @@ char* __cdecl strrchr(const char *str, int c)
  */
 void* __cdecl memchr(const void *ptr, int c, size_t n)
 {
+    uint64_t v = 0x0101010101010101ull * (unsigned char)c;
     const unsigned char *p = ptr;
+    const uint64_t *w;
 
-    for (p = ptr; n; n--, p++) if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
+    for (p = ptr; n && ((ULONG_PTR)p & 7); n--, p++)
+        if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
+    for (w = (const uint64_t *)p; n >= sizeof(*w) && !has_zero_byte(*w ^ v); n -= sizeof(*w)) w++;
+    for (p = (const unsigned char *)w; n; n--, p++)
+        if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
     return NULL;
 }
 
@@ -3281,6 +3351,21 @@ void* __cdecl memchr(const void *ptr, int c, size_t n)
  */
 int __cdecl strcmp(const char *str1, const char *str2)
 {
+    const uint64_t *w1, *w2;
+
+    /* compare 8 bytes at once when both strings have the same alignment */
+    if (!(((ULONG_PTR)str1 ^ (ULONG_PTR)str2) & 7))
+    {
+        while (((ULONG_PTR)str1 & 7) && *str1 && *str1 == *str2) { str1++; str2++; }
+        if (!((ULONG_PTR)str1 & 7))
+        {
+            w1 = (const uint64_t *)str1;
+            w2 = (const uint64_t *)str2;
+            while (*w1 == *w2 && !has_zero_byte(*w1)) { w1++; w2++; }
+            str1 = (const char *)w1;
+            str2 = (const char *)w2;
+        }
+    }
     while (*str1 && *str1 == *str2) { str1++; str2++; }
     if ((unsigned char)*str1 > (unsigned char)*str2) return 1;
     if ((unsigned char)*str1 < (unsigned char)*str2) return -1;
@@ -1962,11 +1962,41 @@ int WINAPIV _swprintf_p_l(wchar_t *buffer, size_t length,
     return r;
 }
 
+/* checks 4 characters at once, the aligned loads never cross a page boundary */
+static inline BOOL has_zero_wchar(UINT64 v)
+{
+    return ((v - 0x0001000100010001ull) & ~v & 0x8000800080008000ull) != 0;
+}
+
 /*********************************************************************
  *              wcscmp (MSVCRT.@)
  */
 int CDECL wcscmp(const wchar_t *str1, const wchar_t *str2)
 {
+    const UINT64 *w1, *w2;
+
+    /* compare 4 characters at once when both strings have the same alignment */
+    if (!(((ULONG_PTR)str1 ^ (ULONG_PTR)str2) & 7))
+    {
+        while (((ULONG_PTR)str1 & 7) && *str1 && (*str1 == *str2))
+        {
+            str1++;
+            str2++;
+        }
+        if (!((ULONG_PTR)str1 & 7))
+        {
+            w1 = (const UINT64 *)str1;
+            w2 = (const UINT64 *)str2;
+            while (*w1 == *w2 && !has_zero_wchar(*w1))
+            {
+                w1++;
+                w2++;
+            }
+            str1 = (const wchar_t *)w1;
+            str2 = (const wchar_t *)w2;
+        }
+    }
+
     while (*str1 && (*str1 == *str2))
     {
         str1++;
@@ -2969,7 +2999,11 @@ wchar_t* CDECL wcsrchr(const wchar_t *str, wchar_t ch)
 size_t CDECL wcslen(const wchar_t *str)
 {
     const wchar_t *s = str;
-    while (*s) s++;
+    const UINT64 *w;
+
+    for (; (ULONG_PTR)s & 7; s++) if (!*s) return s - str;
+    for (w = (const UINT64 *)s; !has_zero_wchar(*w); w++) ;
+    for (s = (const wchar_t *)w; *s; s++) ;
     return s - str;
 }
 
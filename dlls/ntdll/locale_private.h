@@ -309,6 +309,21 @@ static inline unsigned int cp_wcstombs_size( const CPTABLEINFO *info, const WCHA
 }
 
 
+/* 7-bit ASCII runs are checked 8 bytes at a time once the source is aligned */
+#define ASCII_WORD_MASK_A 0x8080808080808080ull
+#define ASCII_WORD_MASK_W 0xff80ff80ff80ff80ull
+
+static inline BOOL is_ascii_word_a( const char *src, const char *srcend )
+{
+    return !((ULONG_PTR)src & 7) && srcend - src >= 8 && !(*(const UINT64 *)src & ASCII_WORD_MASK_A);
+}
+
+static inline BOOL is_ascii_word_w( const WCHAR *src, unsigned int srclen )
+{
+    return !((ULONG_PTR)src & 7) && srclen >= 4 && !(*(const UINT64 *)src & ASCII_WORD_MASK_W);
+}
+
+
 static inline NTSTATUS utf8_wcstombs_size( const WCHAR *src, unsigned int srclen, unsigned int *reslen )
 {
     unsigned int val, len;
@@ -316,6 +331,13 @@ static inline NTSTATUS utf8_wcstombs_size( const WCHAR *src, unsigned int srclen
 
     for (len = 0; srclen; srclen--, src++)
     {
+        while (is_ascii_word_w( src, srclen ))
+        {
+            len += 4;
+            src += 4;
+            srclen -= 4;
+        }
+        if (!srclen) break;
         if (*src < 0x80) len++;  /* 0x00-0x7f: 1 byte */
         else if (*src < 0x800) len += 2;  /* 0x80-0x7ff: 2 bytes */
         else
@@ -347,7 +369,15 @@ static inline NTSTATUS utf8_mbstowcs_size( const char *src, unsigned int srclen,
 
     for (len = 0; src < srcend; len++)
     {
-        unsigned char ch = *src++;
+        unsigned char ch;
+
+        while (is_ascii_word_a( src, srcend ))
+        {
+            len += 8;
+            src += 8;
+        }
+        if (src == srcend) break;
+        ch = *src++;
         if (ch < 0x80) continue;
         if ((res = decode_utf8_char( ch, &src, srcend )) > 0x10ffff)
             status = STATUS_SOME_NOT_MAPPED;
@@ -422,7 +452,7 @@ static inline unsigned int cp_wcstombs( const CPTABLEINFO *info, char *dst, unsi
 static inline NTSTATUS utf8_mbstowcs( WCHAR *dst, unsigned int dstlen, unsigned int *reslen,
                                       const char *src, unsigned int srclen )
 {
-    unsigned int res;
+    unsigned int i, res;
     NTSTATUS status = STATUS_SUCCESS;
     const char *srcend = src + srclen;
     WCHAR *dstend = dst + dstlen;
@@ -433,6 +463,12 @@ static inline NTSTATUS utf8_mbstowcs( WCHAR *dst, unsigned int dstlen, unsigned
         if (ch < 0x80)  /* special fast case for 7-bit ASCII */
         {
             *dst++ = ch;
+            while (dstend - dst >= 8 && is_ascii_word_a( src, srcend ))
+            {
+                for (i = 0; i < 8; i++) dst[i] = (unsigned char)src[i];
+                src += 8;
+                dst += 8;
+            }
             continue;
         }
         if ((res = decode_utf8_char( ch, &src, srcend )) <= 0xffff)
@@ -473,6 +509,16 @@ static inline NTSTATUS utf8_wcstombs( char *dst, unsigned int dstlen, unsigned i
         {
             if (dst > end - 1) break;
             *dst++ = ch;
+            while (end - dst >= 4 && is_ascii_word_w( src + 1, srclen - 1 ))
+            {
+                dst[0] = src[1];
+                dst[1] = src[2];
+                dst[2] = src[3];
+                dst[3] = src[4];
+                dst += 4;
+                src += 4;
+                srclen -= 4;
+            }
             continue;
         }
         if (ch < 0x800)  /* 0x80-0x7ff: 2 bytes */
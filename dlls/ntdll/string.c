@@ -67,31 +67,58 @@ static const unsigned short ctypes[257] =
 };
 
 
+/* checks 8 bytes at once, the aligned loads never cross a page boundary */
+static inline BOOL has_zero_byte( uint64_t v )
+{
+    return ((v - 0x0101010101010101ull) & ~v & 0x8080808080808080ull) != 0;
+}
+
+
 /*********************************************************************
  *                  memchr   (NTDLL.@)
  */
 void * __cdecl memchr( const void *ptr, int c, size_t n )
 {
+    uint64_t v = 0x0101010101010101ull * (unsigned char)c;
     const unsigned char *p = ptr;
+    const uint64_t *w;
 
-    for (p = ptr; n; n--, p++) if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
+    for (p = ptr; n && ((ULONG_PTR)p & 7); n--, p++)
+        if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
+    for (w = (const uint64_t *)p; n >= sizeof(*w) && !has_zero_byte( *w ^ v ); n -= sizeof(*w)) w++;
+    for (p = (const unsigned char *)w; n; n--, p++)
+        if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
     return NULL;
 }
 
 
+static inline int memcmp_bytes( const unsigned char *p1, const unsigned char *p2, size_t n )
+{
+    for (; n; n--, p1++, p2++)
+    {
+        if (*p1 < *p2) return -1;
+        if (*p1 > *p2) return 1;
+    }
+    return 0;
+}
+
+
 /*********************************************************************
  *                  memcmp   (NTDLL.@)
  */
 int __cdecl memcmp( const void *ptr1, const void *ptr2, size_t n )
 {
-    const unsigned char *p1, *p2;
+    typedef uint64_t DECLSPEC_ALIGN(1) unaligned_ui64;
+
+    const unsigned char *p1 = ptr1, *p2 = ptr2;
 
-    for (p1 = ptr1, p2 = ptr2; n; n--, p1++, p2++)
+    while (n >= sizeof(uint64_t) && *(const unaligned_ui64 *)p1 == *(const unaligned_ui64 *)p2)
     {
-        if (*p1 < *p2) return -1;
-        if (*p1 > *p2) return 1;
+        p1 += sizeof(uint64_t);
+        p2 += sizeof(uint64_t);
+        n -= sizeof(uint64_t);
     }
-    return 0;
+    return memcmp_bytes( p1, p2, n );
 }
 
 
@@ -295,6 +322,21 @@ char * __cdecl strchr( const char *str, int c )
  */
 int __cdecl strcmp( const char *str1, const char *str2 )
 {
+    const uint64_t *w1, *w2;
+
+    /* compare 8 bytes at once when both strings have the same alignment */
+    if (!(((ULONG_PTR)str1 ^ (ULONG_PTR)str2) & 7))
+    {
+        while (((ULONG_PTR)str1 & 7) && *str1 && *str1 == *str2) { str1++; str2++; }
+        if (!((ULONG_PTR)str1 & 7))
+        {
+            w1 = (const uint64_t *)str1;
+            w2 = (const uint64_t *)str2;
+            while (*w1 == *w2 && !has_zero_byte( *w1 )) { w1++; w2++; }
+            str1 = (const char *)w1;
+            str2 = (const char *)w2;
+        }
+    }
     while (*str1 && *str1 == *str2) { str1++; str2++; }
     if ((unsigned char)*str1 > (unsigned char)*str2) return 1;
     if ((unsigned char)*str1 < (unsigned char)*str2) return -1;
@@ -350,7 +392,11 @@ size_t __cdecl strcspn( const char *str, const char *reject )
 size_t __cdecl strlen( const char *str )
 {
     const char *s = str;
-    while (*s) s++;
+    const uint64_t *w;
+
+    for (; (ULONG_PTR)s & 7; s++) if (!*s) return s - str;
+    for (w = (const uint64_t *)s; !has_zero_byte( *w ); w++) ;
+    for (s = (const char *)w; *s; s++) ;
     return s - str;
 }
 
@@ -98,6 +98,7 @@ struct timer_queue
  */
 
 #define THREADPOOL_WORKER_TIMEOUT 5000
+#define THREADPOOL_WORKER_SPIN_COUNT 4000
 #define MAXIMUM_WAITQUEUE_OBJECTS (MAXIMUM_WAIT_OBJECTS - 1)
 
 /* internal threadpool representation */
@@ -109,6 +110,8 @@ struct threadpool
     CRITICAL_SECTION        cs;
     /* Pools of work items, locked via .cs, order matches TP_CALLBACK_PRIORITY - high, normal, low. */
     struct list             pools[3];
+    /* incremented whenever a work item is queued, polled without the lock by spinning workers */
+    LONG                    queue_gen;
     RTL_CONDITION_VARIABLE  update_event;
     /* information about worker threads, locked via .cs */
     int                     max_workers;
@@ -610,18 +613,22 @@ static void queue_add_timer(struct queue_timer *t, ULONGLONG time,
 {
     /* We MUST hold the queue cs while calling this function.  */
     struct timer_queue *q = t->q;
-    struct list *ptr = &q->timers;
+    struct list *ptr = list_head(&q->timers);
 
     assert(!q->quit || (t->destroy && time == EXPIRE_NEVER));
 
-    if (time != EXPIRE_NEVER)
-        LIST_FOR_EACH(ptr, &q->timers)
+    /* New timers usually expire last, so search from the end of the list
+       unless the timer goes to the front anyway.  */
+    if (ptr && time < LIST_ENTRY(ptr, struct queue_timer, entry)->expire)
+        ptr = &q->timers;
+    else
+        LIST_FOR_EACH_REV(ptr, &q->timers)
         {
             struct queue_timer *cur = LIST_ENTRY(ptr, struct queue_timer, entry);
-            if (time < cur->expire)
+            if (cur->expire <= time)
                 break;
         }
-    list_add_before(ptr, &t->entry);
+    list_add_after(ptr, &t->entry);
 
     t->expire = time;
 
@@ -1050,6 +1057,35 @@ NTSTATUS WINAPI RtlDeleteTimer(HANDLE TimerQueue, HANDLE Timer,
     return status;
 }
 
+/***********************************************************************
+ *           timerqueue_add_pending    (internal)
+ *
+ * Inserts a timer into the sorted list of pending timers, timerqueue.cs
+ * has to be held. New timeouts usually expire after all existing ones,
+ * so unless the timer becomes the new head the list is searched backwards.
+ */
+static void timerqueue_add_pending( struct threadpool_object *timer )
+{
+    struct threadpool_object *other_timer;
+    struct list *ptr = list_head( &timerqueue.pending_timers );
+
+    if (ptr && timer->u.timer.timeout < LIST_ENTRY( ptr, struct threadpool_object,
+                                                    u.timer.timer_entry )->u.timer.timeout)
+        ptr = &timerqueue.pending_timers;
+    else
+    {
+        LIST_FOR_EACH_REV( ptr, &timerqueue.pending_timers )
+        {
+            other_timer = LIST_ENTRY( ptr, struct threadpool_object, u.timer.timer_entry );
+            assert( other_timer->type == TP_OBJECT_TYPE_TIMER );
+            if (other_timer->u.timer.timeout <= timer->u.timer.timeout)
+                break;
+        }
+    }
+    list_add_after( ptr, &timer->u.timer.timer_entry );
+    timer->u.timer.timer_pending = TRUE;
+}
+
 /***********************************************************************
  *           timerqueue_thread_proc    (internal)
  */
@@ -1089,15 +1125,7 @@ static void CALLBACK timerqueue_thread_proc( void *param )
                 if (timer->u.timer.timeout <= now.QuadPart)
                     timer->u.timer.timeout = now.QuadPart + 1;
 
-                LIST_FOR_EACH_ENTRY( other_timer, &timerqueue.pending_timers,
-                                     struct threadpool_object, u.timer.timer_entry )
-                {
-                    assert( other_timer->type == TP_OBJECT_TYPE_TIMER );
-                    if (timer->u.timer.timeout < other_timer->u.timer.timeout)
-                        break;
-                }
-                list_add_before( &other_timer->u.timer.timer_entry, &timer->u.timer.timer_entry );
-                timer->u.timer.timer_pending = TRUE;
+                timerqueue_add_pending( timer );
             }
         }
 
@@ -1687,6 +1715,7 @@ static NTSTATUS tp_threadpool_alloc( struct threadpool **out )
     pool->min_workers             = 0;
     pool->num_workers             = 0;
     pool->num_busy_workers        = 0;
+    pool->queue_gen               = 0;
     pool->stack_info.StackReserve = nt->OptionalHeader.SizeOfStackReserve;
     pool->stack_info.StackCommit  = nt->OptionalHeader.SizeOfStackCommit;
 
@@ -1971,6 +2000,7 @@ static void tp_object_initialize( struct threadpool_object *object, struct threa
 static void tp_object_prio_queue( struct threadpool_object *object )
 {
     ++object->pool->num_busy_workers;
+    ++object->pool->queue_gen;
     list_add_tail( &object->pool->pools[object->priority], &object->pool_entry );
 }
 
@@ -2326,6 +2356,32 @@ skip_cleanup:
     }
 }
 
+/***********************************************************************
+ *           threadpool_worker_spin    (internal)
+ *
+ * Briefly waits for new work without going to sleep, pool->cs has to be
+ * held. Returns TRUE if the worker should check its queue again.
+ */
+static BOOL threadpool_worker_spin( struct threadpool *pool )
+{
+    ULONG num_procs = NtCurrentTeb()->Peb->NumberOfProcessors;
+    LONG gen = pool->queue_gen;
+    unsigned int i;
+
+    /* Spinning only helps if another thread can submit work meanwhile. */
+    if (num_procs <= 1 || pool->num_busy_workers >= num_procs) return FALSE;
+
+    RtlLeaveCriticalSection( &pool->cs );
+    for (i = 0; i < THREADPOOL_WORKER_SPIN_COUNT; i++)
+    {
+        if (ReadNoFence( &pool->queue_gen ) != gen) break;
+        YieldProcessor();
+    }
+    RtlEnterCriticalSection( &pool->cs );
+
+    return pool->shutdown || threadpool_get_next_item( pool );
+}
+
 /***********************************************************************
  *           threadpool_worker_proc    (internal)
  */
@@ -2364,6 +2420,11 @@ static void CALLBACK threadpool_worker_proc( void *param )
         if (pool->shutdown)
             break;
 
+        /* New work is often submitted right after the previous item finished,
+         * avoid a sleep and wakeup round trip in that case. */
+        if (threadpool_worker_spin( pool ))
+            continue;
+
         /* Wait for new tasks or until the timeout expires. A thread only terminates
          * when no new tasks are available, and the number of threads can be
          * decreased without violating the min_workers limit. An exception is when
@@ -2970,7 +3031,6 @@ BOOL WINAPI TpSetPoolMinThreads( TP_POOL *pool, DWORD minimum )
 VOID WINAPI TpSetTimer( TP_TIMER *timer, LARGE_INTEGER *timeout, LONG period, LONG window_length )
 {
     struct threadpool_object *this = impl_from_TP_TIMER( timer );
-    struct threadpool_object *other_timer;
     BOOL submit_timer = FALSE;
     ULONGLONG timestamp;
 
@@ -3020,20 +3080,11 @@ VOID WINAPI TpSetTimer( TP_TIMER *timer, LARGE_INTEGER *timeout, LONG period, LO
         this->u.timer.period        = period;
         this->u.timer.window_length = window_length;
 
-        LIST_FOR_EACH_ENTRY( other_timer, &timerqueue.pending_timers,
-                             struct threadpool_object, u.timer.timer_entry )
-        {
-            assert( other_timer->type == TP_OBJECT_TYPE_TIMER );
-            if (this->u.timer.timeout < other_timer->u.timer.timeout)
-                break;
-        }
-        list_add_before( &other_timer->u.timer.timer_entry, &this->u.timer.timer_entry );
+        timerqueue_add_pending( this );
 
         /* Wake up the timer thread when the timeout has to be updated. */
         if (list_head( &timerqueue.pending_timers ) == &this->u.timer.timer_entry )
             RtlWakeAllConditionVariable( &timerqueue.update_event );
-
-        this->u.timer.timer_pending = TRUE;
     }
 
     RtlLeaveCriticalSection( &timerqueue.cs );
@@ -209,13 +209,24 @@ errno_t __cdecl wcscpy_s( wchar_t *dst, size_t len, const wchar_t *src )
 }
 
 
+/* checks 4 characters at once, the aligned loads never cross a page boundary */
+static inline BOOL has_zero_wchar( UINT64 v )
+{
+    return ((v - 0x0001000100010001ull) & ~v & 0x8000800080008000ull) != 0;
+}
+
+
 /***********************************************************************
  *           wcslen    (NTDLL.@)
  */
 size_t __cdecl wcslen( LPCWSTR str )
 {
     const WCHAR *s = str;
-    while (*s) s++;
+    const UINT64 *w;
+
+    for (; (ULONG_PTR)s & 7; s++) if (!*s) return s - str;
+    for (w = (const UINT64 *)s; !has_zero_wchar( *w ); w++) ;
+    for (s = (const WCHAR *)w; *s; s++) ;
     return s - str;
 }
 
@@ -265,6 +276,21 @@ LPWSTR __cdecl wcschr( LPCWSTR str, WCHAR ch )
  */
 int __cdecl wcscmp( LPCWSTR str1, LPCWSTR str2 )
 {
+    const UINT64 *w1, *w2;
+
+    /* compare 4 characters at once when both strings have the same alignment */
+    if (!(((ULONG_PTR)str1 ^ (ULONG_PTR)str2) & 7))
+    {
+        while (((ULONG_PTR)str1 & 7) && *str1 && (*str1 == *str2)) { str1++; str2++; }
+        if (!((ULONG_PTR)str1 & 7))
+        {
+            w1 = (const UINT64 *)str1;
+            w2 = (const UINT64 *)str2;
+            while (*w1 == *w2 && !has_zero_wchar( *w1 )) { w1++; w2++; }
+            str1 = (const WCHAR *)w1;
+            str2 = (const WCHAR *)w2;
+        }
+    }
     while (*str1 && (*str1 == *str2)) { str1++; str2++; }
     return *str1 - *str2;
 }
@@ -7173,6 +7173,27 @@ static ULONG BlockChainStream_GetSectorOfOffset(BlockChainStream *This, ULONG of
   return This->indexCache[min_run].firstSector + offset - This->indexCache[min_run].firstOffset;
 }
 
+/* Returns how many of the blocks following the nth block are stored in the
+ * sectors right after it and are not cached, up to max_blocks. */
+static ULONG BlockChainStream_GetContiguousBlocks(BlockChainStream *This,
+    ULONG index, ULONG sector, ULONG max_blocks)
+{
+  ULONG count = 0;
+
+  while (count < max_blocks)
+  {
+    ULONG next = index + count + 1;
+
+    if (This->cachedBlocks[0].index == next || This->cachedBlocks[1].index == next)
+      break;
+    if (BlockChainStream_GetSectorOfOffset(This, next) != sector + count + 1)
+      break;
+    count++;
+  }
+
+  return count;
+}
+
 static HRESULT BlockChainStream_GetBlockAtOffset(BlockChainStream *This,
     ULONG index, BlockChainBlock **block, ULONG *sector, BOOL create)
 {
@@ -7617,7 +7638,14 @@ HRESULT BlockChainStream_ReadAt(BlockChainStream* This,
 
     if (!cachedBlock)
     {
-      /* Not in cache, and we're going to read past the end of the block. */
+      /* Not in cache, and we're going to read past the end of the block.
+       * Read the following blocks in the same call if they are contiguous. */
+      ULONG extraBlocks = BlockChainStream_GetContiguousBlocks(This, blockNoInSequence, blockIndex,
+          (size - bytesToReadInBuffer - 1) / This->parentStorage->bigBlockSize);
+
+      bytesToReadInBuffer += extraBlocks * This->parentStorage->bigBlockSize;
+      blockNoInSequence += extraBlocks;
+
       ulOffset.QuadPart = StorageImpl_GetBigBlockOffset(This->parentStorage, blockIndex) +
                                offsetInBlock;
 
@@ -7701,7 +7729,14 @@ HRESULT BlockChainStream_WriteAt(BlockChainStream* This,
 
     if (!cachedBlock)
     {
-      /* Not in cache, and we're going to write past the end of the block. */
+      /* Not in cache, and we're going to write past the end of the block.
+       * Write the following blocks in the same call if they are contiguous. */
+      ULONG extraBlocks = BlockChainStream_GetContiguousBlocks(This, blockNoInSequence, blockIndex,
+          (size - bytesToWrite - 1) / This->parentStorage->bigBlockSize);
+
+      bytesToWrite += extraBlocks * This->parentStorage->bigBlockSize;
+      blockNoInSequence += extraBlocks;
+
       ulOffset.QuadPart = StorageImpl_GetBigBlockOffset(This->parentStorage, blockIndex) +
                                offsetInBlock;
 
@@ -8049,6 +8084,8 @@ HRESULT SmallBlockChainStream_ReadAt(
 
   while ( (size > 0) && (blockIndex != BLOCK_END_OF_CHAIN) )
   {
+    ULONG lastBlockIndex = blockIndex;
+
     /*
      * Calculate how many bytes we can copy from this small block.
      */
@@ -8063,9 +8100,27 @@ HRESULT SmallBlockChainStream_ReadAt(
 
     offsetInBigBlockFile.QuadPart  += offsetInBlock;
 
+    /*
+     * Step to the next small block, merging the following blocks into the
+     * same read as long as they are stored consecutively.
+     */
+    rc = SmallBlockChainStream_GetNextBlockInChain(This, blockIndex, &blockIndex);
+    if(FAILED(rc))
+      return STG_E_DOCFILECORRUPT;
+
+    while (bytesToReadInBuffer < size && blockIndex == lastBlockIndex + 1)
+    {
+      bytesToReadInBuffer += min(This->parentStorage->smallBlockSize, size - bytesToReadInBuffer);
+      lastBlockIndex = blockIndex;
+
+      rc = SmallBlockChainStream_GetNextBlockInChain(This, blockIndex, &blockIndex);
+      if(FAILED(rc))
+        return STG_E_DOCFILECORRUPT;
+    }
+
     /*
      * Read those bytes in the buffer from the small block file.
-     * The small block has already been identified so it shouldn't fail
+     * The small blocks have already been identified so it shouldn't fail
      * unless the file is corrupt.
      */
     rc = BlockChainStream_ReadAt(This->parentStorage->smallBlockRootChain,
@@ -8080,17 +8135,13 @@ HRESULT SmallBlockChainStream_ReadAt(
     if (!bytesReadFromBigBlockFile)
       return STG_E_DOCFILECORRUPT;
 
-    /*
-     * Step to the next big block.
-     */
-    rc = SmallBlockChainStream_GetNextBlockInChain(This, blockIndex, &blockIndex);
-    if(FAILED(rc))
-      return STG_E_DOCFILECORRUPT;
-
     bufferWalker += bytesReadFromBigBlockFile;
     size         -= bytesReadFromBigBlockFile;
     *bytesRead   += bytesReadFromBigBlockFile;
-    offsetInBlock = (offsetInBlock + bytesReadFromBigBlockFile) % This->parentStorage->smallBlockSize;
+    offsetInBlock = 0;
+
+    if (bytesReadFromBigBlockFile != bytesToReadInBuffer)
+      break;
   }
 
   return S_OK;
@@ -1280,6 +1280,12 @@ typedef struct tagTLBContext
 	void *mapping;        /* memory mapping */
 	MSFT_SegDir * pTblDir;
 	ITypeLibImpl* pLibInfo;
+	TLBString **names;    /* names sorted by offset */
+	unsigned int name_count;
+	TLBString **strings;  /* strings sorted by offset */
+	unsigned int string_count;
+	TLBGuid **guids;      /* guids indexed by offset */
+	unsigned int guid_count;
 } TLBContext;
 
 
@@ -2079,6 +2085,8 @@ static HRESULT MSFT_ReadAllGuids(TLBContext *pcx)
     MSFT_GuidEntry entry;
     int offs = 0;
 
+    pcx->guids = heap_alloc(pcx->pTblDir->pGuidTab.length / sizeof(MSFT_GuidEntry) * sizeof(*pcx->guids));
+
     MSFT_Seek(pcx, pcx->pTblDir->pGuidTab.offset);
     while (1) {
         if (offs >= pcx->pTblDir->pGuidTab.length)
@@ -2093,6 +2101,8 @@ static HRESULT MSFT_ReadAllGuids(TLBContext *pcx)
         guid->hreftype = entry.hreftype;
 
         list_add_tail(&pcx->pLibInfo->guid_list, &guid->entry);
+        if (pcx->guids && offs + sizeof(MSFT_GuidEntry) <= pcx->pTblDir->pGuidTab.length)
+            pcx->guids[pcx->guid_count++] = guid;
 
         offs += sizeof(MSFT_GuidEntry);
     }
@@ -2102,6 +2112,16 @@ static TLBGuid *MSFT_ReadGuid( int offset, TLBContext *pcx)
 {
     TLBGuid *ret;
 
+    if (pcx->guids)
+    {
+        if (offset < 0 || offset % sizeof(MSFT_GuidEntry) ||
+            offset / sizeof(MSFT_GuidEntry) >= pcx->guid_count)
+            return NULL;
+        ret = pcx->guids[offset / sizeof(MSFT_GuidEntry)];
+        TRACE_(typelib)("%s\n", debugstr_guid(&ret->guid));
+        return ret;
+    }
+
     LIST_FOR_EACH_ENTRY(ret, &pcx->pLibInfo->guid_list, TLBGuid, entry){
         if(ret->offset == offset){
             TRACE_(typelib)("%s\n", debugstr_guid(&ret->guid));
@@ -2135,6 +2155,9 @@ static HRESULT MSFT_ReadAllNames(TLBContext *pcx)
     INT16 len_piece;
     int offs = 0, lengthInChars;
 
+    /* each name takes at least 8 bytes */
+    pcx->names = heap_alloc(pcx->pTblDir->pNametab.length / 8 * sizeof(*pcx->names));
+
     MSFT_Seek(pcx, pcx->pTblDir->pNametab.offset);
     while (1) {
         TLBString *tlbstr;
@@ -2170,15 +2193,41 @@ static HRESULT MSFT_ReadAllNames(TLBContext *pcx)
         heap_free(string);
 
         list_add_tail(&pcx->pLibInfo->name_list, &tlbstr->entry);
+        if (pcx->names && pcx->name_count < pcx->pTblDir->pNametab.length / 8)
+            pcx->names[pcx->name_count++] = tlbstr;
 
         offs += len_piece;
     }
 }
 
+/* binary search in a table of strings sorted by offset */
+static TLBString *MSFT_FindString(TLBString **table, unsigned int count, int offset)
+{
+    unsigned int min = 0, max = count;
+
+    while (min < max)
+    {
+        unsigned int pos = (min + max) / 2;
+
+        if (table[pos]->offset == offset)
+        {
+            TRACE_(typelib)("%s\n", debugstr_w(table[pos]->str));
+            return table[pos];
+        }
+        if (table[pos]->offset < (unsigned int)offset) min = pos + 1;
+        else max = pos;
+    }
+
+    return NULL;
+}
+
 static TLBString *MSFT_ReadName( TLBContext *pcx, int offset)
 {
     TLBString *tlbstr;
 
+    if (pcx->names)
+        return MSFT_FindString(pcx->names, pcx->name_count, offset);
+
     LIST_FOR_EACH_ENTRY(tlbstr, &pcx->pLibInfo->name_list, TLBString, entry) {
         if (tlbstr->offset == offset) {
             TRACE_(typelib)("%s\n", debugstr_w(tlbstr->str));
@@ -2193,6 +2242,9 @@ static TLBString *MSFT_ReadString( TLBContext *pcx, int offset)
 {
     TLBString *tlbstr;
 
+    if (pcx->strings)
+        return MSFT_FindString(pcx->strings, pcx->string_count, offset);
+
     LIST_FOR_EACH_ENTRY(tlbstr, &pcx->pLibInfo->string_list, TLBString, entry) {
         if (tlbstr->offset == offset) {
             TRACE_(typelib)("%s\n", debugstr_w(tlbstr->str));
@@ -2767,6 +2819,9 @@ static HRESULT MSFT_ReadAllStrings(TLBContext *pcx)
     INT16 len_str, len_piece;
     int offs = 0, lengthInChars;
 
+    /* each string takes at least 8 bytes */
+    pcx->strings = heap_alloc(pcx->pTblDir->pStringtab.length / 8 * sizeof(*pcx->strings));
+
     MSFT_Seek(pcx, pcx->pTblDir->pStringtab.offset);
     while (1) {
         TLBString *tlbstr;
@@ -2801,6 +2856,8 @@ static HRESULT MSFT_ReadAllStrings(TLBContext *pcx)
         heap_free(string);
 
         list_add_tail(&pcx->pLibInfo->string_list, &tlbstr->entry);
+        if (pcx->strings && pcx->string_count < pcx->pTblDir->pStringtab.length / 8)
+            pcx->strings[pcx->string_count++] = tlbstr;
 
         offs += len_piece;
     }
@@ -3455,6 +3512,12 @@ static ITypeLib2* ITypeLib2_Constructor_MSFT(LPVOID pLib, DWORD dwTLBLength)
     cx.mapping = pLib;
     cx.pLibInfo = pTypeLibImpl;
     cx.length = dwTLBLength;
+    cx.names = NULL;
+    cx.name_count = 0;
+    cx.strings = NULL;
+    cx.string_count = 0;
+    cx.guids = NULL;
+    cx.guid_count = 0;
 
     /* read header */
     MSFT_ReadLEDWords(&tlbHeader, sizeof(tlbHeader), &cx, 0);
@@ -3647,6 +3710,10 @@ static ITypeLib2* ITypeLib2_Constructor_MSFT(LPVOID pLib, DWORD dwTLBLength)
     }
 #endif
 
+    heap_free(cx.names);
+    heap_free(cx.strings);
+    heap_free(cx.guids);
+
     TRACE("(%p)\n", pTypeLibImpl);
     return &pTypeLibImpl->ITypeLib2_iface;
 }
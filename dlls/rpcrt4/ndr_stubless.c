@@ -52,6 +52,38 @@ static inline BOOL is_oicf_stubdesc(const PMIDL_STUB_DESC pStubDesc)
     return pStubDesc->Version >= 0x20000;
 }
 
+/* size of base types that have the same representation in memory and on
+ * the wire, and can thus be copied directly without going through the
+ * generic marshalling routines */
+static inline unsigned int simple_basetype_size(unsigned char fc)
+{
+    switch (fc)
+    {
+    case FC_BYTE:
+    case FC_CHAR:
+    case FC_SMALL:
+    case FC_USMALL:
+        return sizeof(UCHAR);
+    case FC_WCHAR:
+    case FC_SHORT:
+    case FC_USHORT:
+        return sizeof(USHORT);
+    case FC_LONG:
+    case FC_ULONG:
+    case FC_ERROR_STATUS_T:
+    case FC_ENUM32:
+        return sizeof(ULONG);
+    case FC_FLOAT:
+        return sizeof(float);
+    case FC_DOUBLE:
+        return sizeof(double);
+    case FC_HYPER:
+        return sizeof(ULONGLONG);
+    default:
+        return 0;
+    }
+}
+
 static inline void call_buffer_sizer(PMIDL_STUB_MESSAGE pStubMsg, unsigned char *pMemory,
                                      const NDR_PARAM_OIF *param)
 {
@@ -60,6 +92,19 @@ static inline void call_buffer_sizer(PMIDL_STUB_MESSAGE pStubMsg, unsigned char
 
     if (param->attr.IsBasetype)
     {
+        unsigned int size = simple_basetype_size(param->u.type_format_char);
+        if (size)
+        {
+            ULONG len = (pStubMsg->BufferLength + size - 1) & ~(size - 1);
+            if (len + size < len)
+            {
+                ERR("buffer length overflow - BufferLength = %lu, size = %u\n",
+                    pStubMsg->BufferLength, size);
+                RpcRaiseException(RPC_X_BAD_STUB_DATA);
+            }
+            pStubMsg->BufferLength = len + size;
+            return;
+        }
         pFormat = &param->u.type_format_char;
         if (param->attr.IsSimpleRef) pMemory = *(unsigned char **)pMemory;
     }
@@ -86,8 +131,25 @@ static inline unsigned char *call_marshaller(PMIDL_STUB_MESSAGE pStubMsg, unsign
 
     if (param->attr.IsBasetype)
     {
+        unsigned int size = simple_basetype_size(param->u.type_format_char);
         pFormat = &param->u.type_format_char;
         if (param->attr.IsSimpleRef) pMemory = *(unsigned char **)pMemory;
+        if (size)
+        {
+            unsigned char *buffer = pStubMsg->Buffer;
+            unsigned char *end = (unsigned char *)pStubMsg->RpcMsg->Buffer + pStubMsg->BufferLength;
+            ULONG_PTR pad = (size - (ULONG_PTR)buffer) & (size - 1);
+
+            if (buffer + pad + size < buffer || buffer + pad + size > end)
+            {
+                ERR("buffer overflow - Buffer = %p, BufferEnd = %p, size = %u\n", buffer, end, size);
+                RpcRaiseException(RPC_X_BAD_STUB_DATA);
+            }
+            memset(buffer, 0, pad);
+            memcpy(buffer + pad, pMemory, size);
+            pStubMsg->Buffer = buffer + pad + size;
+            return NULL;
+        }
     }
     else
     {
@@ -113,8 +175,25 @@ static inline unsigned char *call_unmarshaller(PMIDL_STUB_MESSAGE pStubMsg, unsi
 
     if (param->attr.IsBasetype)
     {
+        unsigned int size = simple_basetype_size(param->u.type_format_char);
         pFormat = &param->u.type_format_char;
         if (param->attr.IsSimpleRef) ppMemory = (unsigned char **)*ppMemory;
+        /* the server may unmarshal in place, leave that to the generic code */
+        if (size && (fMustAlloc || pStubMsg->IsClient || *ppMemory))
+        {
+            unsigned char *buffer = (unsigned char *)(((ULONG_PTR)pStubMsg->Buffer + size - 1) & ~(ULONG_PTR)(size - 1));
+
+            if (buffer + size < buffer || buffer + size > pStubMsg->BufferEnd)
+            {
+                ERR("buffer overflow - Buffer = %p, BufferEnd = %p, size = %u\n",
+                    buffer, pStubMsg->BufferEnd, size);
+                RpcRaiseException(RPC_X_BAD_STUB_DATA);
+            }
+            if (fMustAlloc) *ppMemory = NdrAllocate(pStubMsg, size);
+            memcpy(*ppMemory, buffer, size);
+            pStubMsg->Buffer = buffer + size;
+            return NULL;
+        }
     }
     else
     {
@@ -68,6 +68,8 @@ typedef struct _RpcConnection_np
     IO_STATUS_BLOCK io_status;
     HANDLE event_cache;
     BOOL read_closed;
+    unsigned char *read_buffer;
+    unsigned int read_buffer_size;
 } RpcConnection_np;
 
 static RpcConnection *rpcrt4_conn_np_alloc(void)
@@ -426,6 +428,83 @@ static int rpcrt4_conn_np_write(RpcConnection *conn, const void *buffer, unsigne
     return count;
 }
 
+static RPC_STATUS rpcrt4_conn_np_receive_fragment(RpcConnection *conn, RpcPktHdr **Header, void **Payload)
+{
+    RpcConnection_np *connection = (RpcConnection_np *)conn;
+    const RpcPktCommonHdr *common_hdr;
+    RPC_STATUS status;
+    DWORD hdr_length;
+    int count, ret;
+
+    *Header = NULL;
+    *Payload = NULL;
+
+    TRACE("(%p, %p, %p)\n", conn, Header, Payload);
+
+    if (!connection->read_buffer)
+    {
+        if (!(connection->read_buffer = malloc(RPC_MAX_PACKET_SIZE)))
+            return RPC_S_OUT_OF_RESOURCES;
+        connection->read_buffer_size = RPC_MAX_PACKET_SIZE;
+    }
+
+    /* the pipe is in message mode and each fragment is written at once, so
+     * usually the whole fragment can be received with a single read instead
+     * of reading the header and the payload separately */
+    count = rpcrt4_conn_np_read(conn, connection->read_buffer, connection->read_buffer_size);
+    if (count < (int)sizeof(*common_hdr))
+    {
+        WARN("Short read of header, %d bytes\n", count);
+        return RPC_S_CALL_FAILED;
+    }
+
+    common_hdr = (const RpcPktCommonHdr *)connection->read_buffer;
+    status = RPCRT4_ValidateCommonHeader(common_hdr);
+    if (status != RPC_S_OK) return status;
+
+    if (common_hdr->frag_len > connection->read_buffer_size)
+    {
+        unsigned char *buffer = realloc(connection->read_buffer, common_hdr->frag_len);
+        if (!buffer) return RPC_S_OUT_OF_RESOURCES;
+        connection->read_buffer = buffer;
+        connection->read_buffer_size = common_hdr->frag_len;
+        common_hdr = (const RpcPktCommonHdr *)buffer;
+    }
+
+    if (count < common_hdr->frag_len)
+    {
+        ret = rpcrt4_conn_np_read(conn, connection->read_buffer + count, common_hdr->frag_len - count);
+        if (ret != common_hdr->frag_len - count)
+        {
+            WARN("bad data length, %d/%d\n", ret, common_hdr->frag_len - count);
+            return RPC_S_CALL_FAILED;
+        }
+    }
+    else if (count > common_hdr->frag_len)
+    {
+        WARN("bad frag length %d, read %d bytes\n", common_hdr->frag_len, count);
+        return RPC_S_PROTOCOL_ERROR;
+    }
+
+    hdr_length = RPCRT4_GetHeaderSize((const RpcPktHdr *)common_hdr);
+    if (!(*Header = malloc(hdr_length)))
+        return RPC_S_OUT_OF_RESOURCES;
+    memcpy(*Header, connection->read_buffer, hdr_length);
+
+    if (common_hdr->frag_len - hdr_length)
+    {
+        if (!(*Payload = malloc(common_hdr->frag_len - hdr_length)))
+        {
+            free(*Header);
+            *Header = NULL;
+            return RPC_S_OUT_OF_RESOURCES;
+        }
+        memcpy(*Payload, connection->read_buffer + hdr_length, common_hdr->frag_len - hdr_length);
+    }
+
+    return RPC_S_OK;
+}
+
 static int rpcrt4_conn_np_close(RpcConnection *conn)
 {
     RpcConnection_np *connection = (RpcConnection_np *) conn;
@@ -445,6 +524,9 @@ static int rpcrt4_conn_np_close(RpcConnection *conn)
         CloseHandle(connection->event_cache);
         connection->event_cache = 0;
     }
+    free(connection->read_buffer);
+    connection->read_buffer = NULL;
+    connection->read_buffer_size = 0;
     return 0;
 }
 
@@ -3131,7 +3213,7 @@ static const struct connection_ops conn_protseq_list[] = {
     rpcrt4_conn_np_wait_for_incoming_data,
     rpcrt4_ncacn_np_get_top_of_tower,
     rpcrt4_ncacn_np_parse_top_of_tower,
-    NULL,
+    rpcrt4_conn_np_receive_fragment,
     RPCRT4_default_is_authorized,
     RPCRT4_default_authorize,
     RPCRT4_default_secure_packet,
@@ -3154,7 +3236,7 @@ static const struct connection_ops conn_protseq_list[] = {
     rpcrt4_conn_np_wait_for_incoming_data,
     rpcrt4_ncalrpc_get_top_of_tower,
     rpcrt4_ncalrpc_parse_top_of_tower,
-    NULL,
+    rpcrt4_conn_np_receive_fragment,
     rpcrt4_ncalrpc_is_authorized,
     rpcrt4_ncalrpc_authorize,
     rpcrt4_ncalrpc_secure_packet,
@@ -28,6 +28,10 @@
  * original version.
  */
 
+#if defined(__i386__) || defined(__x86_64__)
+#include <intrin.h>
+#endif
+
 #include "tomcrypt.h"
 
 static const ulong32 TE0[256] = {
@@ -1061,11 +1065,72 @@ int aes_setup(const unsigned char *key, int keylen, int rounds, aes_key *skey)
     return CRYPT_OK;
 }
 
+#if defined(__i386__) || defined(__x86_64__)
+
+/* The round keys are stored as big endian words, the AES instructions
+   want them in byte order. The decryption schedule is already the
+   equivalent inverse cipher one expected by aesdec. */
+#define AESNI_TARGET __attribute__((target("aes,ssse3")))
+
+static inline __m128i AESNI_TARGET aesni_round_key(const ulong32 *rk)
+{
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)rk), mask);
+}
+
+static void AESNI_TARGET aesni_ecb_encrypt(const unsigned char *pt, unsigned char *ct, aes_key *skey)
+{
+    __m128i s = _mm_loadu_si128((const __m128i *)pt);
+    int r;
+
+    s = _mm_xor_si128(s, aesni_round_key(skey->eK));
+    for (r = 1; r < skey->Nr; r++)
+        s = _mm_aesenc_si128(s, aesni_round_key(skey->eK + 4 * r));
+    s = _mm_aesenclast_si128(s, aesni_round_key(skey->eK + 4 * r));
+    _mm_storeu_si128((__m128i *)ct, s);
+}
+
+static void AESNI_TARGET aesni_ecb_decrypt(const unsigned char *ct, unsigned char *pt, aes_key *skey)
+{
+    __m128i s = _mm_loadu_si128((const __m128i *)ct);
+    int r;
+
+    s = _mm_xor_si128(s, aesni_round_key(skey->dK));
+    for (r = 1; r < skey->Nr; r++)
+        s = _mm_aesdec_si128(s, aesni_round_key(skey->dK + 4 * r));
+    s = _mm_aesdeclast_si128(s, aesni_round_key(skey->dK + 4 * r));
+    _mm_storeu_si128((__m128i *)pt, s);
+}
+
+static int have_aesni(void)
+{
+    static int supported = -1;
+    int regs[4];
+
+    if (supported == -1)
+    {
+        __cpuid(regs, 1);
+        /* SSSE3, AES */
+        supported = (regs[2] & (1 << 9)) && (regs[2] & (1 << 25));
+    }
+    return supported;
+}
+
+#endif
+
 void aes_ecb_encrypt(const unsigned char *pt, unsigned char *ct, aes_key *skey)
 {
     ulong32 s0, s1, s2, s3, t0, t1, t2, t3, *rk;
     int Nr, r;
 
+#if defined(__i386__) || defined(__x86_64__)
+    if (have_aesni())
+    {
+        aesni_ecb_encrypt(pt, ct, skey);
+        return;
+    }
+#endif
+
     Nr = skey->Nr;
     rk = skey->eK;
 
@@ -1167,6 +1232,14 @@ void aes_ecb_decrypt(const unsigned char *ct, unsigned char *pt, aes_key *skey)
     ulong32 s0, s1, s2, s3, t0, t1, t2, t3, *rk;
     int Nr, r;
 
+#if defined(__i386__) || defined(__x86_64__)
+    if (have_aesni())
+    {
+        aesni_ecb_decrypt(ct, pt, skey);
+        return;
+    }
+#endif
+
     Nr = skey->Nr;
     rk = skey->dK;
 
@@ -122,6 +122,7 @@ enum system_queue_index
 
 struct work_item
 {
+    SLIST_ENTRY slist_entry;
     IUnknown IUnknown_iface;
     LONG refcount;
     struct list entry;
@@ -144,6 +145,10 @@ static struct work_item *work_item_impl_from_IUnknown(IUnknown *iface)
     return CONTAINING_RECORD(iface, struct work_item, IUnknown_iface);
 }
 
+/* Released items are kept around for reuse, allocating one per sample is costly. */
+#define MAX_FREE_WORK_ITEMS 256
+static SLIST_HEADER free_work_items;
+
 static const TP_CALLBACK_PRIORITY priorities[] =
 {
     TP_CALLBACK_PRIORITY_HIGH,
@@ -168,12 +173,23 @@ struct queue_desc
     DWORD target_queue;
 };
 
+/* Items submitted to pool queues are pushed without locking to a per-priority
+   list, and picked up by the single work object of that priority. */
+struct queue_lane
+{
+    SLIST_HEADER submitted;
+    SLIST_ENTRY *pending;   /* items taken from 'submitted', oldest first */
+    TP_WORK *work;
+};
+
 struct queue
 {
     IRtwqAsyncCallback IRtwqAsyncCallback_iface;
     const struct queue_ops *ops;
     TP_POOL *pool;
     TP_CALLBACK_ENVIRON_V3 envs[ARRAY_SIZE(priorities)];
+    struct queue_lane lanes[ARRAY_SIZE(priorities)];
+    SRWLOCK lanes_lock;
     CRITICAL_SECTION cs;
     struct list pending_items;
     DWORD id;
@@ -309,6 +325,8 @@ static void CALLBACK standard_queue_cleanup_callback(void *object_data, void *gr
 {
 }
 
+static void CALLBACK standard_queue_worker(TP_CALLBACK_INSTANCE *instance, void *context, TP_WORK *work);
+
 static HRESULT pool_queue_init(const struct queue_desc *desc, struct queue *queue)
 {
     TP_CALLBACK_ENVIRON_V3 env;
@@ -328,6 +346,14 @@ static HRESULT pool_queue_init(const struct queue_desc *desc, struct queue *queu
         queue->envs[i] = env;
         queue->envs[i].CallbackPriority = priorities[i];
     }
+    for (i = 0; i < ARRAY_SIZE(queue->lanes); ++i)
+    {
+        InitializeSListHead(&queue->lanes[i].submitted);
+        queue->lanes[i].pending = NULL;
+        queue->lanes[i].work = CreateThreadpoolWork(standard_queue_worker, queue,
+                (TP_CALLBACK_ENVIRON *)&queue->envs[i]);
+    }
+    InitializeSRWLock(&queue->lanes_lock);
     list_init(&queue->pending_items);
     InitializeCriticalSection(&queue->cs);
 
@@ -342,8 +368,44 @@ static HRESULT pool_queue_init(const struct queue_desc *desc, struct queue *queu
     return S_OK;
 }
 
+static struct work_item *pool_queue_next_item(struct queue *queue)
+{
+    SLIST_ENTRY *entry, *next, *pending;
+    struct queue_lane *lane;
+    unsigned int i;
+
+    AcquireSRWLockExclusive(&queue->lanes_lock);
+
+    /* Lanes are ordered from highest to lowest priority. */
+    for (i = 0, entry = NULL; i < ARRAY_SIZE(queue->lanes) && !entry; ++i)
+    {
+        lane = &queue->lanes[i];
+
+        if (!lane->pending && (entry = InterlockedFlushSList(&lane->submitted)))
+        {
+            /* Restore submission order. */
+            for (pending = NULL; entry; entry = next)
+            {
+                next = entry->Next;
+                entry->Next = pending;
+                pending = entry;
+            }
+            lane->pending = pending;
+        }
+
+        if ((entry = lane->pending))
+            lane->pending = entry->Next;
+    }
+
+    ReleaseSRWLockExclusive(&queue->lanes_lock);
+
+    return entry ? CONTAINING_RECORD(entry, struct work_item, slist_entry) : NULL;
+}
+
 static BOOL pool_queue_shutdown(struct queue *queue)
 {
+    struct work_item *item;
+
     if (!queue->pool)
         return FALSE;
 
@@ -351,13 +413,27 @@ static BOOL pool_queue_shutdown(struct queue *queue)
     CloseThreadpool(queue->pool);
     queue->pool = NULL;
 
+    /* Release items that were cancelled before they had a chance to run. */
+    while ((item = pool_queue_next_item(queue)))
+    {
+        if (item->finalization_callback)
+            IUnknown_Release(&item->IUnknown_iface);
+        IUnknown_Release(&item->IUnknown_iface);
+    }
+
     return TRUE;
 }
 
 static void CALLBACK standard_queue_worker(TP_CALLBACK_INSTANCE *instance, void *context, TP_WORK *work)
 {
-    struct work_item *item = context;
-    RTWQASYNCRESULT *result = (RTWQASYNCRESULT *)item->result;
+    struct work_item *item;
+    RTWQASYNCRESULT *result;
+
+    /* Every submission queues one callback, each callback runs the most urgent pending item. */
+    if (!(item = pool_queue_next_item(context)))
+        return;
+
+    result = (RTWQASYNCRESULT *)item->result;
 
     TRACE("result object %p.\n", result);
 
@@ -367,14 +443,16 @@ static void CALLBACK standard_queue_worker(TP_CALLBACK_INSTANCE *instance, void
 
     IRtwqAsyncCallback_Invoke(result->pCallback, item->reply_result ? item->reply_result : item->result);
 
+    if (item->finalization_callback)
+        item->finalization_callback(instance, item);
+
     IUnknown_Release(&item->IUnknown_iface);
 }
 
 static void pool_queue_submit(struct queue *queue, struct work_item *item)
 {
     TP_CALLBACK_PRIORITY callback_priority;
-    TP_CALLBACK_ENVIRON_V3 env;
-    TP_WORK *work_object;
+    struct queue_lane *lane;
 
     if (item->priority == 0)
         callback_priority = TP_CALLBACK_PRIORITY_NORMAL;
@@ -383,14 +461,14 @@ static void pool_queue_submit(struct queue *queue, struct work_item *item)
     else
         callback_priority = TP_CALLBACK_PRIORITY_HIGH;
 
-    env = queue->envs[callback_priority];
-    env.FinalizationCallback = item->finalization_callback;
-    /* Worker pool callback will release one reference. Grab one more to keep object alive when
+    lane = &queue->lanes[callback_priority];
+
+    /* Worker callback will release one reference. Grab one more to keep object alive when
        we need finalization callback. */
     if (item->finalization_callback)
         IUnknown_AddRef(&item->IUnknown_iface);
-    work_object = CreateThreadpoolWork(standard_queue_worker, item, (TP_CALLBACK_ENVIRON *)&env);
-    SubmitThreadpoolWork(work_object);
+    InterlockedPushEntrySList(&lane->submitted, &item->slist_entry);
+    SubmitThreadpoolWork(lane->work);
 
     TRACE("dispatched %p.\n", item->result);
 }
@@ -420,8 +498,11 @@ static void CALLBACK serial_queue_finalization_callback(PTP_CALLBACK_INSTANCE in
     HRESULT hr;
 
     EnterCriticalSection(&queue->cs);
+    next_item = serial_queue_get_next(queue, item);
+    LeaveCriticalSection(&queue->cs);
 
-    if ((next_item = serial_queue_get_next(queue, item)))
+    /* Head item stays queued until it's finalized, nobody else could dispatch it. */
+    if (next_item)
     {
         if (SUCCEEDED(hr = grab_queue(queue->target_queue, &target_queue)))
             target_queue->ops->submit(target_queue, next_item);
@@ -429,8 +510,6 @@ static void CALLBACK serial_queue_finalization_callback(PTP_CALLBACK_INSTANCE in
             WARN("Failed to grab queue for id %#lx, hr %#lx.\n", queue->target_queue, hr);
     }
 
-    LeaveCriticalSection(&queue->cs);
-
     IUnknown_Release(&item->IUnknown_iface);
 }
 
@@ -507,6 +586,8 @@ static void serial_queue_submit(struct queue *queue, struct work_item *item)
         IUnknown_AddRef(&item->IUnknown_iface);
     }
 
+    LeaveCriticalSection(&queue->cs);
+
     if (next_item)
     {
         if (SUCCEEDED(hr = grab_queue(queue->target_queue, &target_queue)))
@@ -514,8 +595,6 @@ static void serial_queue_submit(struct queue *queue, struct work_item *item)
         else
             WARN("Failed to grab queue for id %#lx, hr %#lx.\n", queue->target_queue, hr);
     }
-
-    LeaveCriticalSection(&queue->cs);
 }
 
 static const struct queue_ops serial_queue_ops =
@@ -554,7 +633,10 @@ static ULONG WINAPI work_item_Release(IUnknown *iface)
         if (item->reply_result)
             IRtwqAsyncResult_Release(item->reply_result);
         IRtwqAsyncResult_Release(item->result);
-        free(item);
+        if (QueryDepthSList(&free_work_items) < MAX_FREE_WORK_ITEMS)
+            InterlockedPushEntrySList(&free_work_items, &item->slist_entry);
+        else
+            free(item);
     }
 
     return refcount;
@@ -572,8 +654,15 @@ static struct work_item * alloc_work_item(struct queue *queue, LONG priority, IR
     RTWQASYNCRESULT *async_result = (RTWQASYNCRESULT *)result;
     DWORD flags = 0, queue_id = 0;
     struct work_item *item;
+    SLIST_ENTRY *entry;
 
-    item = calloc(1, sizeof(*item));
+    if ((entry = InterlockedPopEntrySList(&free_work_items)))
+    {
+        item = CONTAINING_RECORD(entry, struct work_item, slist_entry);
+        memset(item, 0, sizeof(*item));
+    }
+    else if (!(item = calloc(1, sizeof(*item))))
+        return NULL;
 
     item->IUnknown_iface.lpVtbl = &work_item_vtbl;
     item->result = result;
@@ -1156,6 +1245,7 @@ HRESULT WINAPI RtwqStartup(void)
 
 static void shutdown_system_queues(void)
 {
+    SLIST_ENTRY *entry;
     unsigned int i;
     HRESULT hr;
 
@@ -1166,6 +1256,9 @@ static void shutdown_system_queues(void)
         shutdown_queue(&system_queues[i]);
     }
 
+    while ((entry = InterlockedPopEntrySList(&free_work_items)))
+        free(CONTAINING_RECORD(entry, struct work_item, slist_entry));
+
     if (FAILED(hr = CoDecrementMTAUsage(mta_cookie)))
         WARN("Failed to uninitialize MTA, hr %#lx.\n", hr);
 
@@ -30,6 +30,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <pthread.h>
 #include <sys/types.h>
 #include <dlfcn.h>
 #ifdef SONAME_LIBGNUTLS
@@ -47,6 +48,7 @@
 #include "secur32_priv.h"
 
 #include "wine/unixlib.h"
+#include "wine/list.h"
 #include "wine/debug.h"
 
 #if defined(SONAME_LIBGNUTLS)
@@ -111,6 +113,8 @@ MAKE_FUNCPTR(gnutls_record_recv);
 MAKE_FUNCPTR(gnutls_record_send);
 MAKE_FUNCPTR(gnutls_server_name_set);
 MAKE_FUNCPTR(gnutls_session_channel_binding);
+MAKE_FUNCPTR(gnutls_session_get_data);
+MAKE_FUNCPTR(gnutls_session_set_data);
 MAKE_FUNCPTR(gnutls_set_default_priority);
 MAKE_FUNCPTR(gnutls_transport_get_ptr);
 MAKE_FUNCPTR(gnutls_transport_set_errno);
@@ -169,8 +173,121 @@ struct schan_transport
     gnutls_session_t session;
     struct schan_buffers in;
     struct schan_buffers out;
+    UINT64 credentials;
+    char *target;
 };
 
+/* Client sessions are cached per target and credentials handle, so that
+ * later connections to the same server can use an abbreviated handshake. */
+struct session_cache_entry
+{
+    struct list entry;
+    UINT64 credentials;
+    char *target;
+    size_t size;
+    char data[1];
+};
+
+#define SESSION_CACHE_MAX_ENTRIES 64
+
+static struct list session_cache = LIST_INIT(session_cache);
+static unsigned int session_cache_count;
+static pthread_mutex_t session_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void free_session_cache_entry(struct session_cache_entry *entry)
+{
+    list_remove(&entry->entry);
+    session_cache_count--;
+    free(entry);
+}
+
+static struct session_cache_entry *find_session_cache_entry(UINT64 credentials, const char *target)
+{
+    struct session_cache_entry *entry;
+
+    LIST_FOR_EACH_ENTRY(entry, &session_cache, struct session_cache_entry, entry)
+    {
+        if (entry->credentials == credentials && !strcmp(entry->target, target)) return entry;
+    }
+    return NULL;
+}
+
+static void resume_cached_session(struct schan_transport *t)
+{
+    struct session_cache_entry *entry;
+    int err;
+
+    pthread_mutex_lock(&session_cache_mutex);
+    if ((entry = find_session_cache_entry(t->credentials, t->target)))
+    {
+        TRACE("resuming session for %s\n", debugstr_a(t->target));
+        if ((err = pgnutls_session_set_data(t->session, entry->data, entry->size)) != GNUTLS_E_SUCCESS)
+        {
+            pgnutls_perror(err);
+            free_session_cache_entry(entry);
+        }
+        else
+        {
+            list_remove(&entry->entry);
+            list_add_head(&session_cache, &entry->entry);
+        }
+    }
+    pthread_mutex_unlock(&session_cache_mutex);
+}
+
+static void cache_session(struct schan_transport *t)
+{
+    struct session_cache_entry *entry, *old;
+    size_t size = 0, len;
+    int err;
+
+    /* TLS 1.3 tickets arrive after the handshake and retrieving them may
+     * require reading from the transport, so only cache older protocols. */
+    switch (pgnutls_protocol_get_version(t->session))
+    {
+    case GNUTLS_TLS1_0:
+    case GNUTLS_TLS1_1:
+    case GNUTLS_TLS1_2:
+        break;
+    default:
+        return;
+    }
+
+    err = pgnutls_session_get_data(t->session, NULL, &size);
+    if ((err != GNUTLS_E_SUCCESS && err != GNUTLS_E_SHORT_MEMORY_BUFFER) || !size) return;
+
+    len = strlen(t->target) + 1;
+    if (!(entry = malloc(offsetof(struct session_cache_entry, data[size]) + len))) return;
+    if (pgnutls_session_get_data(t->session, entry->data, &size) != GNUTLS_E_SUCCESS)
+    {
+        free(entry);
+        return;
+    }
+    entry->credentials = t->credentials;
+    entry->size = size;
+    entry->target = entry->data + size;
+    memcpy(entry->target, t->target, len);
+
+    pthread_mutex_lock(&session_cache_mutex);
+    if ((old = find_session_cache_entry(t->credentials, t->target))) free_session_cache_entry(old);
+    list_add_head(&session_cache, &entry->entry);
+    if (++session_cache_count > SESSION_CACHE_MAX_ENTRIES)
+        free_session_cache_entry(LIST_ENTRY(list_tail(&session_cache), struct session_cache_entry, entry));
+    pthread_mutex_unlock(&session_cache_mutex);
+}
+
+static void purge_session_cache(UINT64 credentials)
+{
+    struct session_cache_entry *entry, *next;
+
+    pthread_mutex_lock(&session_cache_mutex);
+    LIST_FOR_EACH_ENTRY_SAFE(entry, next, &session_cache, struct session_cache_entry, entry)
+    {
+        if (entry->credentials == credentials) free_session_cache_entry(entry);
+    }
+    pthread_mutex_unlock(&session_cache_mutex);
+}
+
 static int compat_cipher_get_block_size(gnutls_cipher_algorithm_t cipher)
 {
     switch(cipher) {
@@ -521,6 +638,7 @@ static NTSTATUS schan_create_session( void *args )
         return STATUS_INTERNAL_ERROR;
     }
     transport->session = s;
+    if (!(flags & (GNUTLS_SERVER | GNUTLS_DATAGRAM))) transport->credentials = cred->credentials;
 
     if ((status = set_priority(cred, s)))
     {
@@ -554,6 +672,7 @@ static NTSTATUS schan_dispose_session( void *args )
     struct schan_transport *t = (struct schan_transport *)pgnutls_transport_get_ptr(s);
     pgnutls_transport_set_ptr(s, NULL);
     pgnutls_deinit(s);
+    free(t->target);
     free(t);
     return STATUS_SUCCESS;
 }
@@ -562,7 +681,12 @@ static NTSTATUS schan_set_session_target( void *args )
 {
     const struct set_session_target_params *params = args;
     gnutls_session_t s = session_from_handle(params->session);
+    struct schan_transport *t = (struct schan_transport *)pgnutls_transport_get_ptr(s);
+
     pgnutls_server_name_set( s, GNUTLS_NAME_DNS, params->target, strlen(params->target) );
+
+    if (t->credentials && !t->target && (t->target = strdup(params->target)))
+        resume_cached_session(t);
     return STATUS_SUCCESS;
 }
 
@@ -603,6 +727,7 @@ static NTSTATUS schan_handshake( void *args )
         if (err == GNUTLS_E_SUCCESS)
         {
             TRACE("Handshake completed\n");
+            if (t->target) cache_session(t);
             status = SEC_E_OK;
         }
         else if (err == GNUTLS_E_AGAIN)
@@ -1392,6 +1517,7 @@ static NTSTATUS schan_allocate_certificate_credentials( void *args )
 static NTSTATUS schan_free_certificate_credentials( void *args )
 {
     const struct free_certificate_credentials_params *params = args;
+    purge_session_cache(params->c->credentials);
     pgnutls_certificate_free_credentials(certificate_creds_from_handle(params->c->credentials));
     return STATUS_SUCCESS;
 }
@@ -1458,6 +1584,8 @@ static NTSTATUS process_attach( void *args )
     LOAD_FUNCPTR(gnutls_record_send);
     LOAD_FUNCPTR(gnutls_server_name_set)
     LOAD_FUNCPTR(gnutls_session_channel_binding)
+    LOAD_FUNCPTR(gnutls_session_get_data)
+    LOAD_FUNCPTR(gnutls_session_set_data)
     LOAD_FUNCPTR(gnutls_set_default_priority)
     LOAD_FUNCPTR(gnutls_transport_get_ptr)
     LOAD_FUNCPTR(gnutls_transport_set_errno)
@@ -1537,6 +1665,10 @@ fail:
 
 static NTSTATUS process_detach( void *args )
 {
+    struct session_cache_entry *entry, *next;
+
+    LIST_FOR_EACH_ENTRY_SAFE(entry, next, &session_cache, struct session_cache_entry, entry)
+        free_session_cache_entry(entry);
     pgnutls_global_deinit();
     dlclose(libgnutls_handle);
     libgnutls_handle = NULL;
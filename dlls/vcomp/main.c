@@ -60,6 +60,8 @@ static RTL_CRITICAL_SECTION vcomp_section = { &critsect_debug, -1, 0, 0, 0, 0 };
 #define VCOMP_DYNAMIC_FLAGS_GUIDED      0x03
 #define VCOMP_DYNAMIC_FLAGS_INCREMENT   0x40
 
+#define VCOMP_BARRIER_SPIN_COUNT        4000
+
 struct vcomp_thread_data
 {
     struct vcomp_team_data  *team;
@@ -77,12 +79,18 @@ struct vcomp_thread_data
 
     /* section */
     unsigned int            section;
+    int                     num_sections;
 
     /* dynamic */
     unsigned int            dynamic;
     unsigned int            dynamic_type;
     unsigned int            dynamic_begin;
     unsigned int            dynamic_end;
+    unsigned int            dynamic_first;
+    unsigned int            dynamic_last;
+    unsigned int            dynamic_iterations;
+    int                     dynamic_step;
+    unsigned int            dynamic_chunksize;
 };
 
 struct vcomp_team_data
@@ -97,8 +105,8 @@ struct vcomp_team_data
     va_list                 valist;
 
     /* barrier */
-    unsigned int            barrier;
-    int                     barrier_count;
+    LONG                    barrier;
+    LONG                    barrier_count;
 };
 
 struct vcomp_task_data
@@ -108,18 +116,28 @@ struct vcomp_task_data
 
     /* section */
     unsigned int            section;
-    int                     num_sections;
-    int                     section_index;
+    LONG64                  section_state;  /* generation << 32 | next section index */
 
     /* dynamic */
     unsigned int            dynamic;
-    unsigned int            dynamic_first;
-    unsigned int            dynamic_last;
-    unsigned int            dynamic_iterations;
-    int                     dynamic_step;
-    unsigned int            dynamic_chunksize;
+    LONG64                  dynamic_state;  /* generation << 32 | claimed iterations */
 };
 
+/* Claim counters are packed with the generation of the construct they belong
+ * to, so that a thread still working on a finished construct can't claim work
+ * from the next one. All threads of a team pass the same loop parameters, so
+ * those are kept in the thread data and only the claim counter is shared. */
+static inline LONG64 read_claim_state(LONG64 volatile *state)
+{
+    return InterlockedCompareExchange64(state, 0, 0);
+}
+
+static inline void write_claim_state(LONG64 volatile *state, LONG64 value)
+{
+    LONG64 prev;
+    do prev = *state; while (InterlockedCompareExchange64(state, value, prev) != prev);
+}
+
 static void **ptr_from_va_list(va_list valist)
 {
     return *(void ***)&valist;
@@ -1057,25 +1075,40 @@ void CDECL _vcomp_flush(void)
 void CDECL _vcomp_barrier(void)
 {
     struct vcomp_team_data *team_data = vcomp_init_thread_data()->team;
+    LONG barrier;
+    int i;
 
     TRACE("()\n");
 
     if (!team_data)
         return;
 
-    EnterCriticalSection(&vcomp_section);
-    if (++team_data->barrier_count >= team_data->num_threads)
+    barrier = ReadAcquire(&team_data->barrier);
+    if (InterlockedIncrement(&team_data->barrier_count) >= team_data->num_threads)
     {
-        team_data->barrier++;
         team_data->barrier_count = 0;
+        EnterCriticalSection(&vcomp_section);
+        InterlockedIncrement(&team_data->barrier);
         WakeAllConditionVariable(&team_data->cond);
+        LeaveCriticalSection(&vcomp_section);
+        return;
     }
-    else
+
+    /* the other threads are usually close behind, spin for a while before
+     * going to sleep unless the team is larger than the number of cpus */
+    if (team_data->num_threads <= vcomp_num_procs)
     {
-        unsigned int barrier = team_data->barrier;
-        while (team_data->barrier == barrier)
-            SleepConditionVariableCS(&team_data->cond, &vcomp_section, INFINITE);
+        for (i = 0; i < VCOMP_BARRIER_SPIN_COUNT; i++)
+        {
+            if (ReadAcquire(&team_data->barrier) != barrier)
+                return;
+            YieldProcessor();
+        }
     }
+
+    EnterCriticalSection(&vcomp_section);
+    while (ReadAcquire(&team_data->barrier) == barrier)
+        SleepConditionVariableCS(&team_data->cond, &vcomp_section, INFINITE);
     LeaveCriticalSection(&vcomp_section);
 }
 
@@ -1102,20 +1135,21 @@ int CDECL _vcomp_single_begin(int flags)
 {
     struct vcomp_thread_data *thread_data = vcomp_init_thread_data();
     struct vcomp_task_data *task_data = thread_data->task;
-    int ret = FALSE;
+    unsigned int single, prev;
 
     TRACE("(%x): semi-stub\n", flags);
 
-    EnterCriticalSection(&vcomp_section);
     thread_data->single++;
-    if ((int)(thread_data->single - task_data->single) > 0)
+    single = ReadAcquire((LONG *)&task_data->single);
+    while ((int)(thread_data->single - single) > 0)
     {
-        task_data->single = thread_data->single;
-        ret = TRUE;
+        prev = InterlockedCompareExchange((LONG *)&task_data->single, thread_data->single, single);
+        if (prev == single)
+            return TRUE;
+        single = prev;
     }
-    LeaveCriticalSection(&vcomp_section);
 
-    return ret;
+    return FALSE;
 }
 
 void CDECL _vcomp_single_end(void)
@@ -1133,11 +1167,11 @@ void CDECL _vcomp_sections_init(int n)
 
     EnterCriticalSection(&vcomp_section);
     thread_data->section++;
+    thread_data->num_sections = n;
     if ((int)(thread_data->section - task_data->section) > 0)
     {
+        write_claim_state(&task_data->section_state, (LONG64)thread_data->section << 32);
         task_data->section       = thread_data->section;
-        task_data->num_sections  = n;
-        task_data->section_index = 0;
     }
     LeaveCriticalSection(&vcomp_section);
 }
@@ -1146,18 +1180,22 @@ int CDECL _vcomp_sections_next(void)
 {
     struct vcomp_thread_data *thread_data = vcomp_init_thread_data();
     struct vcomp_task_data *task_data = thread_data->task;
-    int i = -1;
+    LONG64 state, prev;
 
     TRACE("()\n");
 
-    EnterCriticalSection(&vcomp_section);
-    if (thread_data->section == task_data->section &&
-        task_data->section_index != task_data->num_sections)
+    state = read_claim_state(&task_data->section_state);
+    for (;;)
     {
-        i = task_data->section_index++;
+        if ((unsigned int)(state >> 32) != thread_data->section ||
+            (int)state == thread_data->num_sections)
+            return -1;
+
+        prev = InterlockedCompareExchange64(&task_data->section_state, state + 1, state);
+        if (prev == state)
+            return (int)state;
+        state = prev;
     }
-    LeaveCriticalSection(&vcomp_section);
-    return i;
 }
 
 void CDECL _vcomp_for_static_simple_init(unsigned int first, unsigned int last, int step,
@@ -1469,15 +1507,16 @@ void CDECL _vcomp_for_dynamic_init(unsigned int flags, unsigned int first, unsig
 
         EnterCriticalSection(&vcomp_section);
         thread_data->dynamic++;
-        thread_data->dynamic_type = type;
+        thread_data->dynamic_type       = type;
+        thread_data->dynamic_first      = first;
+        thread_data->dynamic_last       = last;
+        thread_data->dynamic_iterations = iterations;
+        thread_data->dynamic_step       = step;
+        thread_data->dynamic_chunksize  = chunksize;
         if ((int)(thread_data->dynamic - task_data->dynamic) > 0)
         {
+            write_claim_state(&task_data->dynamic_state, (LONG64)thread_data->dynamic << 32);
             task_data->dynamic              = thread_data->dynamic;
-            task_data->dynamic_first        = first;
-            task_data->dynamic_last         = last;
-            task_data->dynamic_iterations   = iterations;
-            task_data->dynamic_step         = step;
-            task_data->dynamic_chunksize    = chunksize;
         }
         LeaveCriticalSection(&vcomp_section);
     }
@@ -1502,26 +1541,40 @@ int CDECL _vcomp_for_dynamic_next(unsigned int *begin, unsigned int *end)
     else if (thread_data->dynamic_type == VCOMP_DYNAMIC_FLAGS_CHUNKED ||
              thread_data->dynamic_type == VCOMP_DYNAMIC_FLAGS_GUIDED)
     {
-        unsigned int iterations = 0;
-        EnterCriticalSection(&vcomp_section);
-        if (thread_data->dynamic == task_data->dynamic &&
-            task_data->dynamic_iterations != 0)
+        unsigned int claimed, remaining, iterations;
+        LONG64 state, prev;
+
+        state = read_claim_state(&task_data->dynamic_state);
+        for (;;)
         {
-            iterations = min(task_data->dynamic_iterations, task_data->dynamic_chunksize);
+            if ((unsigned int)(state >> 32) != thread_data->dynamic)
+                return 0;
+
+            claimed   = (unsigned int)state;
+            remaining = thread_data->dynamic_iterations - claimed;
+            if (!remaining)
+                return 0;
+
+            iterations = min(remaining, thread_data->dynamic_chunksize);
             if (thread_data->dynamic_type == VCOMP_DYNAMIC_FLAGS_GUIDED &&
-                task_data->dynamic_iterations > num_threads * task_data->dynamic_chunksize)
+                remaining > num_threads * thread_data->dynamic_chunksize)
             {
-                iterations = (task_data->dynamic_iterations + num_threads - 1) / num_threads;
+                iterations = (remaining + num_threads - 1) / num_threads;
             }
-            *begin = task_data->dynamic_first;
-            *end   = task_data->dynamic_first + (iterations - 1) * task_data->dynamic_step;
-            task_data->dynamic_iterations -= iterations;
-            task_data->dynamic_first      += iterations * task_data->dynamic_step;
-            if (!task_data->dynamic_iterations)
-                *end = task_data->dynamic_last;
+            if (!iterations)
+                return 0;
+
+            prev = InterlockedCompareExchange64(&task_data->dynamic_state, state + iterations, state);
+            if (prev == state)
+                break;
+            state = prev;
         }
-        LeaveCriticalSection(&vcomp_section);
-        return iterations != 0;
+
+        *begin = thread_data->dynamic_first + claimed * thread_data->dynamic_step;
+        *end   = *begin + (iterations - 1) * thread_data->dynamic_step;
+        if (iterations == remaining)
+            *end = thread_data->dynamic_last;
+        return 1;
     }
 
     return 0;
@@ -1605,7 +1658,9 @@ void WINAPIV _vcomp_fork(BOOL ifval, int nargs, void *wrapper, ...)
 
     task_data.single            = 0;
     task_data.section           = 0;
+    task_data.section_state     = 0;
     task_data.dynamic           = 0;
+    task_data.dynamic_state     = 0;
 
     thread_data.team            = &team_data;
     thread_data.task            = &task_data;
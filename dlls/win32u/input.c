@@ -857,6 +857,7 @@ SHORT WINAPI NtUserGetAsyncKeyState( INT key )
  */
 DWORD WINAPI NtUserGetQueueStatus( UINT flags )
 {
+    const queue_shm_t *shm;
     DWORD ret;
 
     if (flags & ~(QS_ALLINPUT | QS_ALLPOSTMESSAGE | QS_SMRESULT))
@@ -867,6 +868,10 @@ DWORD WINAPI NtUserGetQueueStatus( UINT flags )
 
     check_for_events( flags );
 
+    /* nothing to clear, we can use the shared status directly */
+    if ((shm = get_user_thread_info()->queue_shm) && !(shm->changed_bits & flags))
+        return MAKELONG( 0, shm->wake_bits & flags );
+
     SERVER_START_REQ( get_queue_status )
     {
         req->clear_bits = flags;
@@ -882,10 +887,13 @@ DWORD WINAPI NtUserGetQueueStatus( UINT flags )
  */
 DWORD get_input_state(void)
 {
+    const queue_shm_t *shm;
     DWORD ret;
 
     check_for_events( QS_INPUT );
 
+    if ((shm = get_user_thread_info()->queue_shm)) return shm->wake_bits & (QS_KEY | QS_MOUSEBUTTON);
+
     SERVER_START_REQ( get_queue_status )
     {
         req->clear_bits = 0;
@@ -1778,6 +1778,100 @@ static BOOL process_hardware_message( MSG *msg, UINT hw_id, const struct hardwar
     return ret;
 }
 
+/***********************************************************************
+ *           map_queue_shm
+ *
+ * Map the shared queue status, the server uses a single mapping for all queues.
+ */
+static const queue_shm_t *map_queue_shm( HANDLE handle, int index )
+{
+    static const queue_shm_t *base;
+    void *ptr = NULL;
+    SIZE_T size = 0;
+
+    if (!base)
+    {
+        if (NtMapViewOfSection( handle, GetCurrentProcess(), &ptr, 0, 0, NULL,
+                                &size, ViewShare, 0, PAGE_READONLY ))
+            return NULL;
+        if (InterlockedCompareExchangePointer( (void **)&base, ptr, NULL ))
+            NtUnmapViewOfSection( GetCurrentProcess(), ptr );
+    }
+    return base + index;
+}
+
+/***********************************************************************
+ *           get_server_queue_handle
+ *
+ * Get a handle to the server message queue for the current thread.
+ */
+static HANDLE get_server_queue_handle(void)
+{
+    struct user_thread_info *thread_info = get_user_thread_info();
+    HANDLE ret, shm_handle = 0;
+    int shm_index = -1;
+
+    if (!(ret = thread_info->server_queue))
+    {
+        SERVER_START_REQ( get_msg_queue )
+        {
+            wine_server_call( req );
+            ret = wine_server_ptr_handle( reply->handle );
+            shm_handle = wine_server_ptr_handle( reply->shm_handle );
+            shm_index = reply->shm_index;
+        }
+        SERVER_END_REQ;
+        thread_info->server_queue = ret;
+        if (!ret) ERR( "Cannot get server thread queue\n" );
+        if (shm_handle)
+        {
+            if (shm_index != -1) thread_info->queue_shm = map_queue_shm( shm_handle, shm_index );
+            NtClose( shm_handle );
+        }
+    }
+    return ret;
+}
+
+/***********************************************************************
+ *           is_queue_idle
+ *
+ * Check the shared queue status to find out whether a get_message request
+ * would return nothing, without having to ask the server.
+ */
+static BOOL is_queue_idle( HWND hwnd, UINT first, UINT last, UINT flags, UINT changed_mask )
+{
+    struct user_thread_info *thread_info = get_user_thread_info();
+    UINT filter = flags >> 16, clear_bits = 0;
+    const queue_shm_t *shm;
+
+    if (!thread_info->server_queue) get_server_queue_handle();
+    if (!(shm = thread_info->queue_shm)) return FALSE;
+
+    /* broadcast requests signal the process idle event */
+    if (hwnd == HWND_TOPMOST) return FALSE;
+    /* let the server report invalid window handles */
+    if (hwnd && hwnd != (HWND)1 && !is_window( hwnd )) return FALSE;
+    /* the server needs to see us regularly, or it will consider the queue hung */
+    if (NtGetTickCount() - thread_info->last_getmsg_time >= 1000) return FALSE;
+    /* the server would have to update the wait masks */
+    if (thread_info->wake_mask != (changed_mask & (QS_SENDMESSAGE | QS_SMRESULT)) ||
+        thread_info->changed_mask != changed_mask)
+        return FALSE;
+
+    if (shm->wake_bits) return FALSE;
+
+    /* the server would have to clear these changed bits */
+    if (!filter) filter = QS_ALLINPUT;
+    if (filter & QS_POSTMESSAGE)
+    {
+        clear_bits |= QS_POSTMESSAGE | QS_HOTKEY | QS_TIMER;
+        if (first == 0 && last == ~0U) clear_bits |= QS_ALLPOSTMESSAGE;
+    }
+    if (filter & QS_INPUT) clear_bits |= QS_INPUT;
+    if (filter & QS_PAINT) clear_bits |= QS_PAINT;
+    return !(shm->changed_bits & clear_bits);
+}
+
 /***********************************************************************
  *           peek_message
  *
@@ -1795,11 +1889,13 @@ static int peek_message( MSG *msg, HWND hwnd, UINT first, UINT last, UINT flags,
     void *buffer;
     size_t buffer_size = 1024;
 
-    if (!(buffer = malloc( buffer_size ))) return -1;
-
     if (!first && !last) last = ~0;
     if (hwnd == HWND_BROADCAST) hwnd = HWND_TOPMOST;
 
+    if (is_queue_idle( hwnd, first, last, flags, changed_mask )) return 0;
+
+    if (!(buffer = malloc( buffer_size ))) return -1;
+
     for (;;)
     {
         NTSTATUS res;
@@ -1819,7 +1915,9 @@ static int peek_message( MSG *msg, HWND hwnd, UINT first, UINT last, UINT flags,
             req->wake_mask = changed_mask & (QS_SENDMESSAGE | QS_SMRESULT);
             req->changed_mask = changed_mask;
             wine_server_set_reply( req, buffer, buffer_size );
-            if (!(res = wine_server_call( req )))
+            res = wine_server_call( req );
+            thread_info->last_getmsg_time = NtGetTickCount();
+            if (!res)
             {
                 size = wine_server_reply_size( reply );
                 info.type        = reply->type;
@@ -2057,30 +2155,6 @@ static void process_sent_messages(void)
     peek_message( &msg, 0, 0, 0, PM_REMOVE | PM_QS_SENDMESSAGE, 0 );
 }
 
-/***********************************************************************
- *           get_server_queue_handle
- *
- * Get a handle to the server message queue for the current thread.
- */
-static HANDLE get_server_queue_handle(void)
-{
-    struct user_thread_info *thread_info = get_user_thread_info();
-    HANDLE ret;
-
-    if (!(ret = thread_info->server_queue))
-    {
-        SERVER_START_REQ( get_msg_queue )
-        {
-            wine_server_call( req );
-            ret = wine_server_ptr_handle( reply->handle );
-        }
-        SERVER_END_REQ;
-        thread_info->server_queue = ret;
-        if (!ret) ERR( "Cannot get server thread queue\n" );
-    }
-    return ret;
-}
-
 /* check for driver events if we detect that the app is not properly consuming messages */
 static inline void check_for_driver_events( UINT msg )
 {
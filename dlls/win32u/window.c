@@ -253,6 +253,68 @@ WND *get_win_ptr( HWND hwnd )
     return win;
 }
 
+/***********************************************************************
+ *           map_window_shm
+ *
+ * Map the window state shared by the server, common to all windows.
+ */
+static const window_shm_t *map_window_shm(void)
+{
+    static const window_shm_t *base;
+    static BOOL failed;
+    HANDLE handle = 0;
+    void *ptr = NULL;
+    SIZE_T size = 0;
+
+    if (base || failed) return base;
+
+    SERVER_START_REQ( get_window_shm )
+    {
+        if (!wine_server_call( req )) handle = wine_server_ptr_handle( reply->handle );
+    }
+    SERVER_END_REQ;
+
+    if (!handle || NtMapViewOfSection( handle, GetCurrentProcess(), &ptr, 0, 0, NULL,
+                                       &size, ViewShare, 0, PAGE_READONLY ))
+        failed = TRUE;
+    else if (InterlockedCompareExchangePointer( (void **)&base, ptr, NULL ))
+        NtUnmapViewOfSection( GetCurrentProcess(), ptr );
+    if (handle) NtClose( handle );
+    return base;
+}
+
+/***********************************************************************
+ *           get_window_shm
+ *
+ * Get a consistent copy of the shared state of a window, typically
+ * one belonging to another process.
+ */
+static BOOL get_window_shm( HWND hwnd, window_shm_t *info )
+{
+    UINT index = (LOWORD(hwnd) - FIRST_USER_HANDLE) >> 1, seq;
+    const window_shm_t *shm;
+
+    if (index >= MAX_WINDOW_SHM_SLOTS || !(shm = map_window_shm())) return FALSE;
+    shm += index;
+
+    for (;;)
+    {
+        seq = __atomic_load_n( &shm->seq, __ATOMIC_ACQUIRE );
+        if (!(seq & 1))
+        {
+            *info = *shm;
+            __atomic_thread_fence( __ATOMIC_ACQUIRE );
+            if (__atomic_load_n( &shm->seq, __ATOMIC_RELAXED ) == seq) break;
+        }
+        YieldProcessor();
+    }
+
+    if (!info->handle) return FALSE;
+    /* truncated handles match any generation */
+    if (HIWORD(hwnd) && HIWORD(hwnd) != 0xffff && info->handle != HandleToUlong( hwnd )) return FALSE;
+    return TRUE;
+}
+
 /***********************************************************************
  *           is_current_thread_window
  *
@@ -289,6 +351,7 @@ HWND is_current_process_window( HWND hwnd )
 /* see IsWindow */
 BOOL is_window( HWND hwnd )
 {
+    window_shm_t info;
     WND *win;
     BOOL ret;
 
@@ -302,6 +365,8 @@ BOOL is_window( HWND hwnd )
     }
 
     /* check other processes */
+    if (get_window_shm( hwnd, &info )) return TRUE;
+
     SERVER_START_REQ( get_window_info )
     {
         req->handle = wine_server_user_handle( hwnd );
@@ -314,6 +379,7 @@ BOOL is_window( HWND hwnd )
 /* see GetWindowThreadProcessId */
 DWORD get_window_thread( HWND hwnd, DWORD *process )
 {
+    window_shm_t info;
     WND *ptr;
     DWORD tid = 0;
 
@@ -333,6 +399,12 @@ DWORD get_window_thread( HWND hwnd, DWORD *process )
     }
 
     /* check other processes */
+    if (ptr == WND_OTHER_PROCESS && get_window_shm( hwnd, &info ))
+    {
+        if (process) *process = info.pid;
+        return info.tid;
+    }
+
     SERVER_START_REQ( get_window_info )
     {
         req->handle = wine_server_user_handle( hwnd );
@@ -349,6 +421,7 @@ DWORD get_window_thread( HWND hwnd, DWORD *process )
 /* see GetParent */
 HWND get_parent( HWND hwnd )
 {
+    window_shm_t info;
     HWND retval = 0;
     WND *win;
 
@@ -358,7 +431,12 @@ HWND get_parent( HWND hwnd )
         return 0;
     }
     if (win == WND_DESKTOP) return 0;
-    if (win == WND_OTHER_PROCESS)
+    if (win == WND_OTHER_PROCESS && get_window_shm( hwnd, &info ))
+    {
+        if (info.style & WS_POPUP) retval = UlongToHandle( info.owner );
+        else if (info.style & WS_CHILD) retval = UlongToHandle( info.parent );
+    }
+    else if (win == WND_OTHER_PROCESS)
     {
         LONG style = get_window_long( hwnd, GWL_STYLE );
         if (style & (WS_POPUP | WS_CHILD))
@@ -489,6 +567,7 @@ HWND get_window_relative( HWND hwnd, UINT rel )
     if (rel == GW_OWNER)  /* this one may be available locally */
     {
         WND *win = get_win_ptr( hwnd );
+        window_shm_t info;
         if (!win)
         {
             RtlSetLastWin32Error( ERROR_INVALID_HANDLE );
@@ -501,6 +580,7 @@ HWND get_window_relative( HWND hwnd, UINT rel )
             release_win_ptr( win );
             return retval;
         }
+        if (get_window_shm( hwnd, &info )) return UlongToHandle( info.owner );
         /* else fall through to server call */
     }
 
@@ -544,6 +624,7 @@ HWND get_window_relative( HWND hwnd, UINT rel )
  */
 static HWND *list_window_parents( HWND hwnd )
 {
+    window_shm_t info;
     WND *win;
     HWND current, *list;
     int i, pos = 0, size = 16, count;
@@ -554,15 +635,22 @@ static HWND *list_window_parents( HWND hwnd )
     for (;;)
     {
         if (!(win = get_win_ptr( current ))) goto empty;
-        if (win == WND_OTHER_PROCESS) break;  /* need to do it the hard way */
         if (win == WND_DESKTOP)
         {
             if (!pos) goto empty;
             list[pos] = 0;
             return list;
         }
-        list[pos] = current = win->parent;
-        release_win_ptr( win );
+        if (win == WND_OTHER_PROCESS)
+        {
+            if (!get_window_shm( current, &info )) break;  /* need to do it the hard way */
+            list[pos] = current = UlongToHandle( info.parent );
+        }
+        else
+        {
+            list[pos] = current = win->parent;
+            release_win_ptr( win );
+        }
         if (!current) return list;
         if (++pos == size - 1)
         {
@@ -658,6 +746,7 @@ HWND *list_window_children( HDESK desktop, HWND hwnd, UNICODE_STRING *class, DWO
 HWND WINAPI NtUserGetAncestor( HWND hwnd, UINT type )
 {
     HWND *list, ret = 0;
+    window_shm_t info;
     WND *win;
 
     switch(type)
@@ -674,6 +763,7 @@ HWND WINAPI NtUserGetAncestor( HWND hwnd, UINT type )
             ret = win->parent;
             release_win_ptr( win );
         }
+        else if (get_window_shm( hwnd, &info )) ret = UlongToHandle( info.parent );
         else /* need to query the server */
         {
             SERVER_START_REQ( get_window_tree )
@@ -972,6 +1062,7 @@ BOOL is_zoomed( HWND hwnd )
 static LONG_PTR get_window_long_size( HWND hwnd, INT offset, UINT size, BOOL ansi )
 {
     LONG_PTR retval = 0;
+    window_shm_t info;
     WND *win;
 
     if (offset == GWLP_HWNDPARENT)
@@ -1017,6 +1108,17 @@ static LONG_PTR get_window_long_size( HWND hwnd, INT offset, UINT size, BOOL ans
             RtlSetLastWin32Error( ERROR_ACCESS_DENIED );
             return 0;
         }
+        if (offset < 0 && get_window_shm( hwnd, &info ))
+        {
+            switch (offset)
+            {
+            case GWL_STYLE:      return info.style;
+            case GWL_EXSTYLE:    return info.ex_style;
+            case GWLP_ID:        return info.id;
+            case GWLP_HINSTANCE: return (ULONG_PTR)wine_server_get_ptr( info.instance );
+            case GWLP_USERDATA:  return info.user_data;
+            }
+        }
         SERVER_START_REQ( set_window_info )
         {
             req->handle = wine_server_user_handle( hwnd );
@@ -1550,6 +1652,77 @@ static void mirror_rect( const RECT *window_rect, RECT *rect )
     rect->right = width - tmp;
 }
 
+static RECT rect_from_shm( const rectangle_t *rect )
+{
+    RECT ret = { rect->left, rect->top, rect->right, rect->bottom };
+    return ret;
+}
+
+/***********************************************************************
+ *           get_window_rects_shm
+ *
+ * Compute the window rectangles from the shared window state, the same
+ * way the server does it.
+ */
+static BOOL get_window_rects_shm( HWND hwnd, enum coords_relative relative, RECT *window_rect,
+                                  RECT *client_rect, UINT dpi )
+{
+    window_shm_t info, parent;
+    RECT window, client, rect;
+    user_handle_t next;
+    int depth = 0;
+
+    if (!get_window_shm( hwnd, &info )) return FALSE;
+    /* scaling may need the monitor DPI, leave it to the server */
+    if (info.dpi != dpi) return FALSE;
+
+    window = rect_from_shm( &info.window_rect );
+    client = rect_from_shm( &info.client_rect );
+
+    switch (relative)
+    {
+    case COORDS_CLIENT:
+        OffsetRect( &window, -info.client_rect.left, -info.client_rect.top );
+        OffsetRect( &client, -info.client_rect.left, -info.client_rect.top );
+        rect = rect_from_shm( &info.client_rect );
+        if (info.ex_style & WS_EX_LAYOUTRTL) mirror_rect( &rect, &window );
+        break;
+    case COORDS_WINDOW:
+        OffsetRect( &window, -info.window_rect.left, -info.window_rect.top );
+        OffsetRect( &client, -info.window_rect.left, -info.window_rect.top );
+        rect = rect_from_shm( &info.window_rect );
+        if (info.ex_style & WS_EX_LAYOUTRTL) mirror_rect( &rect, &client );
+        break;
+    case COORDS_PARENT:
+        if (!info.parent) break;
+        if (!get_window_shm( UlongToHandle( info.parent ), &parent )) return FALSE;
+        if (parent.ex_style & WS_EX_LAYOUTRTL)
+        {
+            rect = rect_from_shm( &parent.client_rect );
+            mirror_rect( &rect, &window );
+            mirror_rect( &rect, &client );
+        }
+        break;
+    case COORDS_SCREEN:
+        for (next = info.parent; next; next = parent.parent)
+        {
+            /* the entries are read one at a time, don't trust the chain blindly */
+            if (++depth > 256) return FALSE;
+            if (!get_window_shm( UlongToHandle( next ), &parent )) return FALSE;
+            if (!parent.parent) break;  /* desktop window */
+            OffsetRect( &window, parent.client_rect.left, parent.client_rect.top );
+            OffsetRect( &client, parent.client_rect.left, parent.client_rect.top );
+        }
+        break;
+    default:
+        return FALSE;
+    }
+
+    if (window_rect) *window_rect = window;
+    if (client_rect) *client_rect = client;
+    return TRUE;
+}
+
 /***********************************************************************
  *           get_window_rects
  *
@@ -1660,6 +1833,8 @@ BOOL get_window_rects( HWND hwnd, enum coords_relative relative, RECT *window_re
     }
 
 other_process:
+    if (get_window_rects_shm( hwnd, relative, window_rect, client_rect, dpi )) return TRUE;
+
     SERVER_START_REQ( get_window_rectangles )
     {
         req->handle = wine_server_user_handle( hwnd );
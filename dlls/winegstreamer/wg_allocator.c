@@ -40,6 +40,8 @@ typedef struct
     GstMemory parent;
     struct list entry;
 
+    /* only allocated when no sample could be provided, or to copy its data back */
+    GstAllocationParams unix_params;
     GstMemory *unix_memory;
     GstMapInfo unix_map_info;
 
@@ -66,6 +68,25 @@ typedef struct
 
 G_DEFINE_TYPE(WgAllocator, wg_allocator, GST_TYPE_ALLOCATOR);
 
+static bool wg_memory_alloc_unix(WgMemory *memory)
+{
+    if (memory->unix_memory)
+        return true;
+
+    if (!(memory->unix_memory = gst_allocator_alloc(NULL, memory->parent.maxsize, &memory->unix_params)))
+        return false;
+    if (!gst_memory_map(memory->unix_memory, &memory->unix_map_info, GST_MAP_WRITE))
+    {
+        gst_memory_unref(memory->unix_memory);
+        memory->unix_memory = NULL;
+        return false;
+    }
+
+    GST_INFO("Allocated unix_memory %p, data %p, for memory %p", memory->unix_memory,
+            memory->unix_map_info.data, memory);
+    return true;
+}
+
 static gpointer wg_allocator_map(GstMemory *gst_memory, GstMapInfo *info, gsize maxsize)
 {
     WgAllocator *allocator = (WgAllocator *)gst_memory->allocator;
@@ -79,7 +100,7 @@ static gpointer wg_allocator_map(GstMemory *gst_memory, GstMapInfo *info, gsize
     pthread_mutex_lock(&allocator->mutex);
 
     if (!memory->sample)
-        info->data = memory->unix_map_info.data;
+        info->data = wg_memory_alloc_unix(memory) ? memory->unix_map_info.data : NULL;
     else
     {
         InterlockedIncrement(&memory->sample->refcount);
@@ -155,8 +176,10 @@ static GstMemory *wg_allocator_alloc(GstAllocator *gst_allocator, gsize size,
     memory = g_slice_new0(WgMemory);
     gst_memory_init(GST_MEMORY_CAST(memory), 0, GST_ALLOCATOR_CAST(allocator),
             NULL, size, 0, 0, size);
-    memory->unix_memory = gst_allocator_alloc(NULL, size, params);
-    gst_memory_map(memory->unix_memory, &memory->unix_map_info, GST_MAP_WRITE);
+    if (!params)
+        gst_allocation_params_init(&memory->unix_params);
+    else
+        memory->unix_params = *params;
 
     pthread_mutex_lock(&allocator->mutex);
 
@@ -170,8 +193,7 @@ static GstMemory *wg_allocator_alloc(GstAllocator *gst_allocator, gsize size,
 
     pthread_mutex_unlock(&allocator->mutex);
 
-    GST_INFO("Allocated memory %p, sample %p, unix_memory %p, data %p", memory,
-            memory->sample, memory->unix_memory, memory->unix_map_info.data);
+    GST_INFO("Allocated memory %p, sample %p", memory, memory->sample);
     return (GstMemory *)memory;
 }
 
@@ -192,8 +214,11 @@ static void wg_allocator_free(GstAllocator *gst_allocator, GstMemory *gst_memory
 
     pthread_mutex_unlock(&allocator->mutex);
 
-    gst_memory_unmap(memory->unix_memory, &memory->unix_map_info);
-    gst_memory_unref(memory->unix_memory);
+    if (memory->unix_memory)
+    {
+        gst_memory_unmap(memory->unix_memory, &memory->unix_map_info);
+        gst_memory_unref(memory->unix_memory);
+    }
     g_slice_free(WgMemory, memory);
 }
 
@@ -238,7 +263,10 @@ static void release_memory_sample(WgAllocator *allocator, WgMemory *memory, bool
     if (memory->written && !discard_data)
     {
         GST_WARNING("Copying %#zx bytes from sample %p, back to memory %p", memory->written, sample, memory);
-        memcpy(memory->unix_map_info.data, memory->sample->data, memory->written);
+        if (wg_memory_alloc_unix(memory))
+            memcpy(memory->unix_map_info.data, memory->sample->data, memory->written);
+        else
+            GST_ERROR("Failed to allocate memory %p data", memory);
     }
 
     memory->sample = NULL;
@@ -850,6 +850,38 @@ typedef struct
 } cursor_pos_t;
 
 
+typedef volatile struct
+{
+    unsigned int wake_bits;
+    unsigned int changed_bits;
+} queue_shm_t;
+
+#define MAX_QUEUE_SHM_SLOTS 32768
+
+
+typedef struct
+{
+    unsigned int   seq;
+    user_handle_t  handle;
+    user_handle_t  parent;
+    user_handle_t  owner;
+    thread_id_t    tid;
+    process_id_t   pid;
+    atom_t         atom;
+    unsigned int   style;
+    unsigned int   ex_style;
+    unsigned int   dpi;
+    lparam_t       id;
+    mod_handle_t   instance;
+    lparam_t       user_data;
+    rectangle_t    window_rect;
+    rectangle_t    client_rect;
+} window_shm_t;
+
+
+#define MAX_WINDOW_SHM_SLOTS ((LAST_USER_HANDLE - FIRST_USER_HANDLE + 1) >> 1)
+
+
 
 
 
@@ -2648,7 +2680,9 @@ struct get_msg_queue_reply
 {
     struct reply_header __header;
     obj_handle_t handle;
-    char __pad_12[4];
+    obj_handle_t shm_handle;
+    int          shm_index;
+    char __pad_20[4];
 };
 
 
@@ -3180,6 +3214,20 @@ struct set_window_owner_reply
 
 
 
+struct get_window_shm_request
+{
+    struct request_header __header;
+    char __pad_12[4];
+};
+struct get_window_shm_reply
+{
+    struct reply_header __header;
+    obj_handle_t handle;
+    char __pad_12[4];
+};
+
+
+
 struct get_window_info_request
 {
     struct request_header __header;
@@ -5646,6 +5694,7 @@ enum request
     REQ_destroy_window,
     REQ_get_desktop_window,
     REQ_set_window_owner,
+    REQ_get_window_shm,
     REQ_get_window_info,
     REQ_set_window_info,
     REQ_set_parent,
@@ -5931,6 +5980,7 @@ union generic_request
     struct destroy_window_request destroy_window_request;
     struct get_desktop_window_request get_desktop_window_request;
     struct set_window_owner_request set_window_owner_request;
+    struct get_window_shm_request get_window_shm_request;
     struct get_window_info_request get_window_info_request;
     struct set_window_info_request set_window_info_request;
     struct set_parent_request set_parent_request;
@@ -6214,6 +6264,7 @@ union generic_reply
     struct destroy_window_reply destroy_window_reply;
     struct get_desktop_window_reply get_desktop_window_reply;
     struct set_window_owner_reply set_window_owner_reply;
+    struct get_window_shm_reply get_window_shm_reply;
     struct get_window_info_reply get_window_info_reply;
     struct set_window_info_reply set_window_info_reply;
     struct set_parent_reply set_parent_reply;
@@ -6358,7 +6409,7 @@ union generic_reply
 
 /* ### protocol_version begin ### */
 
-#define SERVER_PROTOCOL_VERSION 762
+#define SERVER_PROTOCOL_VERSION 764
 
 /* ### protocol_version end ### */
 
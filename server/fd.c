@@ -460,25 +460,38 @@ struct timeout_user *add_timeout_user( timeout_t when, timeout_callback func, vo
     user->callback = func;
     user->private  = private;
 
-    /* Now insert it in the linked list */
+    /* Now insert it in the linked list. New timeouts usually expire after the
+     * existing ones, so search from the end unless it goes to the front anyway. */
 
     if (user->when > 0)
     {
-        LIST_FOR_EACH( ptr, &abs_timeout_list )
+        if ((ptr = list_head( &abs_timeout_list )) &&
+            LIST_ENTRY( ptr, struct timeout_user, entry )->when >= user->when)
+            ptr = &abs_timeout_list;
+        else
         {
-            struct timeout_user *timeout = LIST_ENTRY( ptr, struct timeout_user, entry );
-            if (timeout->when >= user->when) break;
+            LIST_FOR_EACH_REV( ptr, &abs_timeout_list )
+            {
+                struct timeout_user *timeout = LIST_ENTRY( ptr, struct timeout_user, entry );
+                if (timeout->when < user->when) break;
+            }
         }
     }
     else
     {
-        LIST_FOR_EACH( ptr, &rel_timeout_list )
+        if ((ptr = list_head( &rel_timeout_list )) &&
+            LIST_ENTRY( ptr, struct timeout_user, entry )->when <= user->when)
+            ptr = &rel_timeout_list;
+        else
         {
-            struct timeout_user *timeout = LIST_ENTRY( ptr, struct timeout_user, entry );
-            if (timeout->when <= user->when) break;
+            LIST_FOR_EACH_REV( ptr, &rel_timeout_list )
+            {
+                struct timeout_user *timeout = LIST_ENTRY( ptr, struct timeout_user, entry );
+                if (timeout->when > user->when) break;
+            }
         }
     }
-    list_add_before( ptr, &user->entry );
+    list_add_after( ptr, &user->entry );
     return user;
 }
 
@@ -141,6 +141,7 @@ struct msg_queue
     struct hook_table     *hooks;           /* hook table */
     timeout_t              last_get_msg;    /* time of last get message call */
     int                    keystate_lock;   /* owns an input keystate lock */
+    int                    shm_index;       /* index in the shared queue status, -1 if none */
 };
 
 struct hotkey
@@ -231,9 +232,51 @@ static unsigned int last_input_time;
 static cursor_pos_t cursor_history[64];
 static unsigned int cursor_history_latest;
 
+/* queue status shared with the clients, so that they can tell when a queue is empty */
+static struct object *queue_shm_mapping;
+static queue_shm_t *queue_shm;
+static unsigned char queue_shm_used[MAX_QUEUE_SHM_SLOTS];
+static unsigned int queue_shm_next;
+
 static void queue_hardware_message( struct desktop *desktop, struct message *msg, int always_queue );
 static void free_message( struct message *msg );
 
+/* allocate a slot in the shared queue status */
+static int alloc_queue_shm_slot(void)
+{
+    unsigned int i, index, error;
+
+    if (!queue_shm_mapping)
+    {
+        /* the shared status is only an optimization, don't fail the request */
+        error = get_error();
+        queue_shm_mapping = create_shared_mapping( MAX_QUEUE_SHM_SLOTS * sizeof(*queue_shm),
+                                                   (void **)&queue_shm );
+        set_error( error );
+        if (!queue_shm_mapping) return -1;
+    }
+
+    for (i = 0; i < MAX_QUEUE_SHM_SLOTS; i++)
+    {
+        index = (queue_shm_next + i) % MAX_QUEUE_SHM_SLOTS;
+        if (queue_shm_used[index]) continue;
+        queue_shm_used[index] = 1;
+        queue_shm_next = index + 1;
+        queue_shm[index].wake_bits = 0;
+        queue_shm[index].changed_bits = 0;
+        return index;
+    }
+    return -1;
+}
+
+/* mirror the queue bits into the shared queue status */
+static inline void update_queue_shm( struct msg_queue *queue )
+{
+    if (queue->shm_index == -1) return;
+    queue_shm[queue->shm_index].wake_bits = queue->wake_bits;
+    queue_shm[queue->shm_index].changed_bits = queue->changed_bits;
+}
+
 /* set the caret window in a given thread input */
 static void set_caret_window( struct thread_input *input, user_handle_t win )
 {
@@ -309,6 +352,7 @@ static struct msg_queue *create_msg_queue( struct thread *thread, struct thread_
         queue->hooks           = NULL;
         queue->last_get_msg    = current_time;
         queue->keystate_lock   = 0;
+        queue->shm_index       = alloc_queue_shm_slot();
         list_init( &queue->send_result );
         list_init( &queue->callback_result );
         list_init( &queue->pending_timers );
@@ -516,6 +560,7 @@ static inline void set_queue_bits( struct msg_queue *queue, unsigned int bits )
     }
     queue->wake_bits |= bits;
     queue->changed_bits |= bits;
+    update_queue_shm( queue );
     if (is_signaled( queue )) wake_up( &queue->obj, 0 );
 }
 
@@ -524,6 +569,7 @@ static inline void clear_queue_bits( struct msg_queue *queue, unsigned int bits
 {
     queue->wake_bits &= ~bits;
     queue->changed_bits &= ~bits;
+    update_queue_shm( queue );
     if (!(queue->wake_bits & (QS_KEY | QS_MOUSEBUTTON)))
     {
         if (queue->keystate_lock) unlock_input_keystate( queue->input );
@@ -1077,6 +1123,12 @@ static void msg_queue_destroy( struct object *obj )
     release_object( queue->input );
     if (queue->hooks) release_object( queue->hooks );
     if (queue->fd) release_object( queue->fd );
+    if (queue->shm_index != -1)
+    {
+        queue_shm[queue->shm_index].wake_bits = 0;
+        queue_shm[queue->shm_index].changed_bits = 0;
+        queue_shm_used[queue->shm_index] = 0;
+    }
 }
 
 static void msg_queue_poll_event( struct fd *fd, int event )
@@ -2400,7 +2452,13 @@ DECL_HANDLER(get_msg_queue)
     struct msg_queue *queue = get_current_queue();
 
     reply->handle = 0;
-    if (queue) reply->handle = alloc_handle( current->process, queue, SYNCHRONIZE, 0 );
+    reply->shm_handle = 0;
+    reply->shm_index = -1;
+    if (!queue) return;
+    if (!(reply->handle = alloc_handle( current->process, queue, SYNCHRONIZE, 0 ))) return;
+    if (queue->shm_index != -1 &&
+        (reply->shm_handle = alloc_handle( current->process, queue_shm_mapping, SECTION_MAP_READ, 0 )))
+        reply->shm_index = queue->shm_index;
 }
 
 
@@ -2459,6 +2517,7 @@ DECL_HANDLER(get_queue_status)
         reply->wake_bits    = queue->wake_bits;
         reply->changed_bits = queue->changed_bits;
         queue->changed_bits &= ~req->clear_bits;
+        update_queue_shm( queue );
     }
     else reply->wake_bits = reply->changed_bits = 0;
 }
@@ -2639,6 +2698,7 @@ DECL_HANDLER(get_message)
     }
     if (filter & QS_INPUT) queue->changed_bits &= ~QS_INPUT;
     if (filter & QS_PAINT) queue->changed_bits &= ~QS_PAINT;
+    update_queue_shm( queue );
 
     /* then check for posted messages */
     if ((filter & QS_POSTMESSAGE) &&
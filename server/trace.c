@@ -2590,6 +2590,8 @@ static void dump_get_msg_queue_request( const struct get_msg_queue_request *req
 static void dump_get_msg_queue_reply( const struct get_msg_queue_reply *req )
 {
     fprintf( stderr, " handle=%04x", req->handle );
+    fprintf( stderr, ", shm_handle=%04x", req->shm_handle );
+    fprintf( stderr, ", shm_index=%d", req->shm_index );
 }
 
 static void dump_set_queue_fd_request( const struct set_queue_fd_request *req )
@@ -2935,6 +2937,15 @@ static void dump_set_window_owner_reply( const struct set_window_owner_reply *re
     fprintf( stderr, ", prev_owner=%08x", req->prev_owner );
 }
 
+static void dump_get_window_shm_request( const struct get_window_shm_request *req )
+{
+}
+
+static void dump_get_window_shm_reply( const struct get_window_shm_reply *req )
+{
+    fprintf( stderr, " handle=%04x", req->handle );
+}
+
 static void dump_get_window_info_request( const struct get_window_info_request *req )
 {
     fprintf( stderr, " handle=%08x", req->handle );
@@ -4654,6 +4665,7 @@ static const dump_func req_dumpers[REQ_NB_REQUESTS] = {
     (dump_func)dump_destroy_window_request,
     (dump_func)dump_get_desktop_window_request,
     (dump_func)dump_set_window_owner_request,
+    (dump_func)dump_get_window_shm_request,
     (dump_func)dump_get_window_info_request,
     (dump_func)dump_set_window_info_request,
     (dump_func)dump_set_parent_request,
@@ -4935,6 +4947,7 @@ static const dump_func reply_dumpers[REQ_NB_REQUESTS] = {
     NULL,
     (dump_func)dump_get_desktop_window_reply,
     (dump_func)dump_set_window_owner_reply,
+    (dump_func)dump_get_window_shm_reply,
     (dump_func)dump_get_window_info_reply,
     (dump_func)dump_set_window_info_reply,
     (dump_func)dump_set_parent_reply,
@@ -5216,6 +5229,7 @@ static const char * const req_names[REQ_NB_REQUESTS] = {
     "destroy_window",
     "get_desktop_window",
     "set_window_owner",
+    "get_window_shm",
     "get_window_info",
     "set_window_info",
     "set_parent",
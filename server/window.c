@@ -30,6 +30,8 @@
 #include "ntuser.h"
 
 #include "object.h"
+#include "file.h"
+#include "handle.h"
 #include "request.h"
 #include "thread.h"
 #include "process.h"
@@ -150,6 +152,10 @@ static struct window *shell_listview;
 static struct window *progman_window;
 static struct window *taskman_window;
 
+/* window state shared with the clients, indexed by user handle */
+static struct object *window_shm_mapping;
+static window_shm_t *window_shm;
+
 /* magic HWND_TOP etc. pointers */
 #define WINPTR_TOP       ((struct window *)1L)
 #define WINPTR_BOTTOM    ((struct window *)2L)
@@ -245,6 +251,70 @@ static inline void update_pixel_format_flags( struct window *win )
         win->paint_flags |= PAINT_PIXEL_FORMAT_CHILD;
 }
 
+/* create the shared window state mapping */
+static int init_window_shm(void)
+{
+    unsigned int error;
+
+    if (window_shm_mapping) return 1;
+
+    /* the shared state is only an optimization, don't fail the request */
+    error = get_error();
+    window_shm_mapping = create_shared_mapping( MAX_WINDOW_SHM_SLOTS * sizeof(*window_shm),
+                                                (void **)&window_shm );
+    set_error( error );
+    return window_shm_mapping != NULL;
+}
+
+/* get the shared state entry of a window */
+static window_shm_t *get_window_shm( user_handle_t handle )
+{
+    unsigned int index = ((handle & 0xffff) - FIRST_USER_HANDLE) >> 1;
+
+    if (index >= MAX_WINDOW_SHM_SLOTS || !init_window_shm()) return NULL;
+    return &window_shm[index];
+}
+
+/* publish the state of a window to the clients */
+static void update_window_shm( struct window *win )
+{
+    window_shm_t *shm;
+
+    if (!win->handle || !(shm = get_window_shm( win->handle ))) return;
+
+    /* clients retry their reads while the sequence number is odd or has changed */
+    __atomic_store_n( &shm->seq, shm->seq + 1, __ATOMIC_RELAXED );
+    __atomic_thread_fence( __ATOMIC_RELEASE );
+    shm->handle      = win->handle;
+    shm->parent      = win->parent ? win->parent->handle : 0;
+    shm->owner       = win->owner;
+    shm->tid         = win->thread ? get_thread_id( win->thread ) : 0;
+    shm->pid         = win->thread ? get_process_id( win->thread->process ) : 0;
+    shm->atom        = win->thread ? (win->class ? get_class_atom( win->class ) : DESKTOP_ATOM) : 0;
+    shm->style       = win->style;
+    shm->ex_style    = win->ex_style;
+    shm->dpi         = win->dpi;
+    shm->id          = win->id;
+    shm->instance    = win->instance;
+    shm->user_data   = win->user_data;
+    shm->window_rect = win->window_rect;
+    shm->client_rect = win->client_rect;
+    __atomic_store_n( &shm->seq, shm->seq + 1, __ATOMIC_RELEASE );
+}
+
+/* remove a window from the shared state */
+static void clear_window_shm( struct window *win )
+{
+    window_shm_t *shm;
+
+    if (!(shm = get_window_shm( win->handle ))) return;
+
+    __atomic_store_n( &shm->seq, shm->seq + 1, __ATOMIC_RELAXED );
+    __atomic_thread_fence( __ATOMIC_RELEASE );
+    shm->handle = 0;
+    __atomic_store_n( &shm->seq, shm->seq + 1, __ATOMIC_RELEASE );
+}
+
 /* get the per-monitor DPI for a window */
 static unsigned int get_monitor_dpi( struct window *win )
 {
@@ -354,6 +424,7 @@ static int set_parent_window( struct window *win, struct window *parent )
         win->is_linked = 0;
         win->is_orphan = 1;
     }
+    update_window_shm( win );
     return 1;
 }
 
@@ -492,6 +563,7 @@ static void detach_window_thread( struct window *win )
     /* destroyed when the desktop ref count reaches zero */
     release_object( win->desktop );
     win->thread = NULL;
+    update_window_shm( win );
 }
 
 /* get the process owning the top window of a given desktop */
@@ -1824,8 +1896,10 @@ static void set_window_pos( struct window *win, struct window *previous,
             offset_rect( &child->visible_rect, new_size - old_size, 0 );
             offset_rect( &child->surface_rect, new_size - old_size, 0 );
             offset_rect( &child->client_rect, new_size - old_size, 0 );
+            update_window_shm( child );
         }
     }
+    update_window_shm( win );
 
     /* reset cursor clip rectangle when the desktop changes size */
     if (win == win->desktop->top_window) win->desktop->cursor.clip = *window_rect;
@@ -2041,6 +2115,7 @@ void free_window_handle( struct window *win )
     detach_window_thread( win );
 
     if (win->parent) set_parent_window( win, NULL );
+    clear_window_shm( win );
     free_user_handle( win->handle );
     win->handle = 0;
     release_object( win );
@@ -2096,6 +2171,7 @@ DECL_HANDLER(create_window)
     }
     win->style = req->style;
     win->ex_style = req->ex_style;
+    update_window_shm( win );
 
     reply->handle    = win->handle;
     reply->parent    = win->parent ? win->parent->handle : 0;
@@ -2161,8 +2237,8 @@ DECL_HANDLER(get_desktop_window)
     {
         if ((desktop->top_window = create_window( NULL, NULL, DESKTOP_ATOM, 0 )))
         {
-            detach_window_thread( desktop->top_window );
             desktop->top_window->style  = WS_POPUP | WS_VISIBLE | WS_CLIPSIBLINGS | WS_CLIPCHILDREN;
+            detach_window_thread( desktop->top_window );
         }
     }
 
@@ -2173,8 +2249,8 @@ DECL_HANDLER(get_desktop_window)
         atom_t atom = add_global_atom( NULL, &name );
         if (atom && (desktop->msg_window = create_window( NULL, NULL, atom, 0 )))
         {
-            detach_window_thread( desktop->msg_window );
             desktop->msg_window->style = WS_POPUP | WS_CLIPSIBLINGS | WS_CLIPCHILDREN;
+            detach_window_thread( desktop->msg_window );
         }
     }
 
@@ -2210,6 +2286,19 @@ DECL_HANDLER(set_window_owner)
 
     reply->prev_owner = win->owner;
     reply->full_owner = win->owner = owner ? owner->handle : 0;
+    update_window_shm( win );
+}
+
+
+/* get a handle to the shared window state */
+DECL_HANDLER(get_window_shm)
+{
+    if (!init_window_shm())
+    {
+        set_error( STATUS_NOT_SUPPORTED );
+        return;
+    }
+    reply->handle = alloc_handle( current->process, window_shm_mapping, SECTION_MAP_READ, 0 );
 }
 
 
@@ -2284,6 +2373,7 @@ DECL_HANDLER(set_window_info)
 
     /* changing window style triggers a non-client paint */
     if (req->flags & SET_WIN_STYLE) win->paint_flags |= PAINT_NONCLIENT;
+    if (req->flags) update_window_shm( win );
 }
 
 